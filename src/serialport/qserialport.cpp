@@ -9,8 +9,16 @@
 #include "qserialportinfo_p.h"
 
 #include "qserialport_p.h"
+#include "qserialportcapture_p.h"
+#include "qserialportlz4_p.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -51,974 +59,3189 @@ QSerialPortErrorInfo::QSerialPortErrorInfo(QSerialPort::SerialPortError newError
 }
 
 QSerialPortPrivate::QSerialPortPrivate()
-#if defined(Q_OS_WIN32)
-    : readChunkBuffer(QSERIALPORT_BUFFERSIZE, 0)
-#endif
+    : backend(std::make_unique<QSerialPortNativeBackend>())
 {
     writeBufferChunkSize = QSERIALPORT_BUFFERSIZE;
     readBufferChunkSize = QSERIALPORT_BUFFERSIZE;
+    backend->d = this;
 }
 
 void QSerialPortPrivate::setError(const QSerialPortErrorInfo &errorInfo)
 {
     Q_Q(QSerialPort);
 
+    if (errorsDeferred) {
+        deferredErrors.append(errorInfo);
+        return;
+    }
+
     q->setErrorString(errorInfo.errorString);
     error.setValue(errorInfo.errorCode);
     error.notify();
     emit q->errorOccurred(error);
 }
 
-/*!
-    \class QSerialPort
+qint64 QSerialPortPrivate::writeDataBounded(const char *data, qint64 maxSize)
+{
+    if (writeBufferPolicy == QSerialPort::DropOldestWhenFull) {
+        qint64 size = maxSize;
+        if (size > writeBufferMaxSize) {
+            // Only the newest part of the data fits into the buffer at all.
+            data += size - writeBufferMaxSize;
+            size = writeBufferMaxSize;
+        }
+        const qint64 excess = writeBuffer.size() + size - writeBufferMaxSize;
+        if (excess > 0)
+            writeBuffer.skip(excess);
+        if (backend->queueWrite(data, size) < 0)
+            return -1;
+        if (excess > 0 || size < maxSize || writeBuffer.size() >= writeBufferMaxSize)
+            emitWriteBufferFull();
+        return maxSize;
+    }
 
-    \brief Provides functions to access serial ports.
+    QDeadlineTimer deadline(writeBufferTimeout);
+    qint64 written = 0;
 
-    \reentrant
-    \ingroup serialport-main
-    \inmodule QtSerialPort
-    \since 5.1
+    for (;;) {
+        const qint64 chunk = qMin(maxSize - written, writeBufferMaxSize - writeBuffer.size());
+        if (chunk > 0) {
+            if (backend->queueWrite(data + written, chunk) < 0)
+                return (written > 0) ? written : qint64(-1);
+            written += chunk;
+        }
 
-    You can get information about the available serial ports using the
-    QSerialPortInfo helper class, which allows an enumeration of all the serial
-    ports in the system. This is useful to obtain the correct name of the
-    serial port you want to use. You can pass an object
-    of the helper class as an argument to the setPort() or setPortName()
-    methods to assign the desired serial device.
+        if (writeBuffer.size() >= writeBufferMaxSize)
+            emitWriteBufferFull();
 
-    After setting the port, you can open it in read-only (r/o), write-only
-    (w/o), or read-write (r/w) mode using the open() method.
+        if (written == maxSize
+                || writeBufferPolicy != QSerialPort::BlockWhenFull
+                || deadline.hasExpired()) {
+            break;
+        }
 
-    \note The serial port is always opened with exclusive access
-    (that is, no other process or thread can access an already opened serial port).
+        // Wait until the driver takes some of the buffered data.
+        const int msecs = int(deadline.remainingTime());
+        if (!backend->waitForDataWritten(msecs))
+            break;
+    }
 
-    Use the close() method to close the port and cancel the I/O operations.
+    return written;
+}
 
-    Having successfully opened, QSerialPort tries to determine the current
-    configuration of the port and initializes itself. You can reconfigure the
-    port to the desired setting using the setBaudRate(), setDataBits(),
-    setParity(), setStopBits(), and setFlowControl() methods.
+/*
+    Waits until the bounded write buffer has room for \a size bytes, for
+    data that has to be queued whole. Queued data is never dropped for it,
+    whatever the policy; only BlockWhenFull waits for the driver. Data
+    larger than the whole buffer fits once the buffer is empty.
+*/
+bool QSerialPortPrivate::waitForWriteRoom(qint64 size)
+{
+    QDeadlineTimer deadline(writeBufferTimeout);
+    while (!writeBuffer.isEmpty() && writeBuffer.size() + size > writeBufferMaxSize) {
+        if (writeBufferPolicy != QSerialPort::BlockWhenFull || deadline.hasExpired()) {
+            emitWriteBufferFull();
+            return false;
+        }
+        const int msecs = int(deadline.remainingTime());
+        if (!backend->waitForDataWritten(msecs)) {
+            emitWriteBufferFull();
+            return false;
+        }
+    }
+    return true;
+}
 
-    There are a couple of properties to work with the pinout signals namely:
-    QSerialPort::dataTerminalReady, QSerialPort::requestToSend. It is also
-    possible to use the pinoutSignals() method to query the current pinout
-    signals set.
+/*
+    Queues \a size bytes whole or not at all. Returns \a size, 0 if the
+    bounded write buffer has no room for them, or -1 on error.
+*/
+qint64 QSerialPortPrivate::writeRecord(const char *data, qint64 size)
+{
+    if (writeBufferMaxSize <= 0 || writeBufferBoundBypassed)
+        return backend->queueWrite(data, size);
+
+    if (!waitForWriteRoom(size))
+        return 0;
+    if (backend->queueWrite(data, size) < 0)
+        return -1;
+    if (writeBuffer.size() >= writeBufferMaxSize)
+        emitWriteBufferFull();
+    return size;
+}
 
-    Once you know that the ports are ready to read or write, you can
-    use the read() or write() methods. Alternatively the
-    readLine() and readAll() convenience methods can also be invoked.
-    If not all the data is read at once, the remaining data will
-    be available for later as new incoming data is appended to the
-    QSerialPort's internal read buffer. You can limit the size of the read
-    buffer using setReadBufferSize().
+void QSerialPortPrivate::emitWriteBufferFull()
+{
+    Q_Q(QSerialPort);
 
-    QSerialPort provides a set of functions that suspend the
-    calling thread until certain signals are emitted. These functions
-    can be used to implement blocking serial ports:
+    if (!writeBufferFullEmitted) {
+        writeBufferFullEmitted = true;
+        emit q->writeBufferFull();
+    }
+}
 
-    \list
+/*
+    Returns a receive chunk of QSERIALPORT_BUFFERSIZE bytes, preferring
+    a pooled chunk that is no longer referenced by the read buffer or
+    the application.
+*/
+QByteArray QSerialPortPrivate::takeReadChunk()
+{
+    for (qsizetype i = readChunkPool.size() - 1; i >= 0; --i) {
+        if (readChunkPool.at(i).isDetached()) {
+            QByteArray chunk = readChunkPool.takeAt(i);
+            chunk.resize(QSERIALPORT_BUFFERSIZE);
+            return chunk;
+        }
+    }
+    return QByteArray(QSERIALPORT_BUFFERSIZE, Qt::Uninitialized);
+}
 
-    \li waitForReadyRead() blocks calls until new data is available for
-    reading.
+/*
+    Returns where to read up to \a maxSize bytes from the driver. After a
+    small read, the next one goes straight into the tail of the read
+    buffer, without a copy; after a large one, into a pooled chunk that is
+    handed over to the read buffer whole, see appendReadChunk(). Data that
+    is processed before it reaches the read buffer always uses a chunk.
+    commitRead() completes the read.
+*/
+char *QSerialPortPrivate::reserveRead(qint64 maxSize)
+{
+    readIntoChunk = isReadDataProcessed() || previousReadSize >= QSERIALPORT_BUFFERSIZE / 8;
+    if (!readIntoChunk)
+        return buffer.reserve(maxSize);
+    currentReadChunk = takeReadChunk();
+    return currentReadChunk.data();
+}
 
-    \li waitForBytesWritten() blocks calls until one payload of data has
-    been written to the serial port.
+/*
+    Completes a read of \a size bytes, or -1 on error, into \a data as
+    returned by reserveRead(\a maxSize). Returns the number of bytes
+    appended to the read buffer.
+*/
+qint64 QSerialPortPrivate::commitRead(char *data, qint64 maxSize, qint64 size)
+{
+    previousReadSize = size;
+    if (readIntoChunk)
+        return appendReadChunk(std::exchange(currentReadChunk, QByteArray()), size);
+
+    const qint64 readBytes = qMax(size, qint64(0));
+    if (captureDevice && readBytes > 0)
+        captureRecord(QSerialPortCapture::ReadRecord, data, readBytes);
+    buffer.chop(maxSize - readBytes);
+    return readBytes;
+}
 
-    \endlist
+/*
+    Appends the first \a size bytes of \a chunk to the read buffer. Small
+    reads are copied into the tail of the read buffer and the chunk is
+    returned to the pool right away; larger reads hand the chunk itself
+    over, and a shared copy stays in the pool to be recycled later.
 
-    See the following example:
+    With compression, filters, a data handler or a framing set, the bytes
+    are passed to them instead and the chunk goes back to the pool.
 
-    \code
-     int numRead = 0, numReadTotal = 0;
-     char buffer[50];
+    Returns the number of bytes appended to the read buffer.
+*/
+qint64 QSerialPortPrivate::appendReadChunk(QByteArray &&chunk, qint64 size)
+{
+    if (captureDevice && size > 0)
+        captureRecord(QSerialPortCapture::ReadRecord, chunk.constData(), size);
+
+    if (isReadDataProcessed()) {
+        qint64 newBytes = 0;
+        if (size > 0)
+            newBytes = receiveReadData(QByteArrayView(chunk.constData(), size));
+        readChunkPool.append(std::move(chunk));
+        return newBytes;
+    }
 
-     for (;;) {
-         numRead  = serial.read(buffer, 50);
+    if (size >= QSERIALPORT_BUFFERSIZE / 8) {
+        chunk.truncate(size);
+        if (readChunkPool.size() < QSERIALPORT_READCHUNKPOOLSIZE)
+            readChunkPool.append(chunk);
+        buffer.append(std::move(chunk));
+    } else {
+        if (size > 0)
+            buffer.append(chunk.constData(), size);
+        readChunkPool.append(std::move(chunk));
+    }
+    return qMax(size, qint64(0));
+}
 
-         // Do whatever with the array
+/*
+    Passes received data through the decompressor and the filters, if any,
+    and on to the data handler and the frame decoder or to the read buffer.
+    Returns the number of bytes appended to the read buffer.
+*/
+qint64 QSerialPortPrivate::receiveReadData(QByteArrayView data)
+{
+    filteredReadBytes = 0;
+    if (compression != QSerialPort::NoCompression)
+        decompressInbound(data);
+    else
+        filterInbound(0, data);
+    return filteredReadBytes;
+}
 
-         numReadTotal += numRead;
-         if (numRead == 0 && !serial.waitForReadyRead())
-             break;
-     }
-    \endcode
+/*
+    Runs data through the inbound filters from \a stage on. Every filter
+    passes its output on right away, so a chunk travels the whole chain
+    while it is still in the cache.
+*/
+void QSerialPortPrivate::filterInbound(qsizetype stage, QByteArrayView data)
+{
+    if (stage < filters.size()) {
+        QSerialPortFilter::Output output(this, QSerialPortFilter::Output::Inbound, stage);
+        filters.at(stage)->processInbound(data, output);
+        return;
+    }
 
-    If \l{QIODevice::}{waitForReadyRead()} returns \c false, the
-    connection has been closed or an error has occurred.
+    if (isReadBufferBypassed()) {
+        consumeReadData(data);
+    } else {
+        buffer.append(data.data(), data.size());
+        filteredReadBytes += data.size();
+    }
+}
 
-    If an error occurs at any point in time, QSerialPort will emit the
-    errorOccurred() signal. You can also call error() to find the type of
-    error that occurred last.
+// Runs data through the outbound filters, the last one added going first
+void QSerialPortPrivate::filterOutbound(qsizetype stage, QByteArrayView data)
+{
+    if (stage < filters.size()) {
+        QSerialPortFilter::Output output(this, QSerialPortFilter::Output::Outbound, stage);
+        filters.at(filters.size() - 1 - stage)->processOutbound(data, output);
+        return;
+    }
 
-    Programming with a blocking serial port is radically different from
-    programming with a non-blocking serial port. A blocking serial port
-    does not require an event loop and typically leads to simpler code.
-    However, in a GUI application, blocking serial port should only be
-    used in non-GUI threads, to avoid freezing the user interface.
+    if (!filteredWriteFailed && writeUnfiltered(data.data(), data.size()) != data.size())
+        filteredWriteFailed = true;
+}
 
-    For more details about these approaches, refer to the
-    \l {Qt Serial Port Examples}{example} applications.
+/*
+    Queues data whole or not at all: a bounded write buffer has to have
+    room for all of \a maxSize bytes. What the filters and the compression
+    make of the data is then queued whole as well, even if it overshoots
+    the bound by what they add. Returns \a maxSize, 0 if there is no room,
+    or -1 on error.
+*/
+qint64 QSerialPortPrivate::writeWhole(const char *data, qint64 maxSize)
+{
+    if (writeBufferMaxSize > 0 && !writeBufferBoundBypassed && !waitForWriteRoom(maxSize))
+        return 0;
+    const bool bypassed = std::exchange(writeBufferBoundBypassed, true);
+    const qint64 written = writeFiltered(data, maxSize);
+    writeBufferBoundBypassed = bypassed;
+    return written;
+}
+
+qint64 QSerialPortPrivate::writeFiltered(const char *data, qint64 maxSize)
+{
+    if (filters.isEmpty())
+        return writeUnfiltered(data, maxSize);
+    filteredWriteFailed = false;
+    filterOutbound(0, QByteArrayView(data, maxSize));
+    return filteredWriteFailed ? qint64(-1) : maxSize;
+}
+
+qint64 QSerialPortPrivate::writeUnfiltered(const char *data, qint64 maxSize)
+{
+    if (compression != QSerialPort::NoCompression)
+        return compressOutbound(data, maxSize);
+    return writeRaw(data, maxSize);
+}
+
+qint64 QSerialPortPrivate::writeRaw(const char *data, qint64 maxSize)
+{
+    if (writeBufferMaxSize > 0 && !writeBufferBoundBypassed)
+        return writeDataBounded(data, maxSize);
+    return backend->queueWrite(data, maxSize);
+}
+
+void QSerialPortPrivate::consumeReadData(QByteArrayView data)
+{
+    Q_Q(QSerialPort);
+
+    if (dataHandler)
+        dataHandler(data);
+
+    if (frameCodec.framing() != QSerialPort::NoFraming) {
+        // Emit after decoding, a receiver may change the framing
+        QList<QByteArray> frames;
+        frameCodec.decode(data, &frames);
+        for (const QByteArray &frame : std::as_const(frames))
+            emit q->frameReceived(frame);
+    }
+}
+
+/*
+    Collects written data into blocks of QSERIALPORT_LZ4BLOCKSIZE bytes and
+    writes every full block compressed. The rest waits for more data or for
+    the flush timeout; large writes are compressed straight from \a data.
+
+    Every block is queued whole or not at all, so the block headers stay in
+    step with a bounded write buffer. Returns the number of bytes taken
+    from \a data, including those kept in compressPending; a full block
+    refused by the write buffer stays there for the next write.
+*/
+qint64 QSerialPortPrivate::compressOutbound(const char *data, qint64 maxSize)
+{
+    const char *p = data;
+    const char *const end = data + maxSize;
+    qint64 written = 0;
+    bool refused = false;
+    if (!compressPending.isEmpty()) {
+        const qint64 size = qMin<qint64>(end - p, QSERIALPORT_LZ4BLOCKSIZE - compressPending.size());
+        compressPending.append(p, size);
+        p += size;
+        if (compressPending.size() == QSERIALPORT_LZ4BLOCKSIZE) {
+            written = writeCompressedBlock(compressPending);
+            refused = written <= 0;
+            if (!refused)
+                compressPending.clear();
+        }
+    }
+    while (!refused && end - p >= QSERIALPORT_LZ4BLOCKSIZE) {
+        written = writeCompressedBlock(QByteArrayView(p, QSERIALPORT_LZ4BLOCKSIZE));
+        refused = written <= 0;
+        if (!refused)
+            p += QSERIALPORT_LZ4BLOCKSIZE;
+    }
+    if (!refused) {
+        compressPending.append(p, end - p);
+        p = end;
+    }
+    compressionFlushDeferred = refused && !compressPending.isEmpty();
+
+    scheduleCompressionFlush();
+    if (refused && p == data)
+        return written;
+    return p - data;
+}
+
+void QSerialPortPrivate::scheduleCompressionFlush()
+{
+    if (compressPending.isEmpty() || compressionFlushDeferred) {
+        if (compressionFlushTimer)
+            compressionFlushTimer->stop();
+    } else if (compressionFlushTimeout == 0) {
+        flushCompression();
+    } else if (!compressionFlushTimer || !compressionFlushTimer->isActive()) {
+        // The first byte waiting sets the deadline, later writes do not
+        // postpone it
+        startCompressionFlushTimer(compressionFlushTimeout);
+    }
+}
+
+void QSerialPortPrivate::startCompressionFlushTimer(int msecs)
+{
+    Q_Q(QSerialPort);
+
+    if (!compressionFlushTimer) {
+        compressionFlushTimer = new QTimer(q);
+        compressionFlushTimer->setSingleShot(true);
+        QObjectPrivate::connect(compressionFlushTimer, &QTimer::timeout,
+                                this, &QSerialPortPrivate::flushCompression);
+    }
+    compressionFlushTimer->start(msecs);
+}
+
+qint64 QSerialPortPrivate::writeCompressedBlock(QByteArrayView block)
+{
+    const qsizetype capacity = QSerialPortLz4::HeaderSize + block.size();
+    if (compressBlock.size() < capacity)
+        compressBlock.resize(capacity);
+    char *out = compressBlock.data();
+
+    // Anything that does not get smaller is stored as it is
+    qsizetype stored = QSerialPortLz4::compress(block.data(), block.size(),
+                                                out + QSerialPortLz4::HeaderSize,
+                                                block.size() - 1);
+    if (stored == 0) {
+        stored = block.size();
+        ::memcpy(out + QSerialPortLz4::HeaderSize, block.data(), stored);
+    }
+    qToLittleEndian<quint16>(quint16(stored), out);
+    qToLittleEndian<quint16>(quint16(block.size()), out + 2);
+
+    const qint64 size = QSerialPortLz4::HeaderSize + stored;
+    const qint64 written = writeRecord(out, size);
+    if (written > 0) {
+        compressionStats.plainWritten += block.size();
+        compressionStats.packedWritten += size;
+    }
+    return written;
+}
+
+/*
+    Writes the data waiting for a full block as a shorter block.
+*/
+bool QSerialPortPrivate::flushCompression()
+{
+    if (compressionFlushTimer)
+        compressionFlushTimer->stop();
+    compressionFlushDeferred = false;
+    if (compressPending.isEmpty())
+        return true;
+    const qint64 written = writeCompressedBlock(compressPending);
+    if (written == 0)
+        compressionFlushDeferred = true;
+    else
+        compressPending.clear();
+    return written > 0;
+}
+
+/*
+    Splits received data into blocks, decompresses them and passes them on
+    to the filters. An incomplete block waits for the rest of it.
+
+    Corrupted data leaves no way to find the next block header, so all
+    data is dropped from then on, until the compression is set again, the
+    input is cleared or the serial port is closed.
+*/
+void QSerialPortPrivate::decompressInbound(QByteArrayView data)
+{
+    if (decompressFailed)
+        return;
+
+    // A receiver may change the compression, which discards the pending data
+    QByteArray pending = std::exchange(decompressPending, QByteArray());
+    QByteArrayView input = data;
+    if (!pending.isEmpty()) {
+        pending.append(data);
+        input = pending;
+    }
+
+    qsizetype offset = 0;
+    while (input.size() - offset >= QSerialPortLz4::HeaderSize) {
+        const char *header = input.data() + offset;
+        const qsizetype stored = qFromLittleEndian<quint16>(header);
+        const qsizetype size = qFromLittleEndian<quint16>(header + 2);
+        if (size == 0 || size > QSERIALPORT_LZ4BLOCKSIZE || stored == 0 || stored > size) {
+            decompressFailed = true;
+            setError(QSerialPortErrorInfo(QSerialPort::ReadError,
+                                          QSerialPort::tr("Corrupted compressed data")));
+            return;
+        }
+        if (input.size() - offset - QSerialPortLz4::HeaderSize < stored)
+            break;
+
+        QByteArrayView block(header + QSerialPortLz4::HeaderSize, stored);
+        if (stored < size) {
+            if (decompressBlock.size() < size)
+                decompressBlock.resize(QSERIALPORT_LZ4BLOCKSIZE);
+            if (QSerialPortLz4::decompress(block.data(), stored,
+                                           decompressBlock.data(), size) != size) {
+                decompressFailed = true;
+                setError(QSerialPortErrorInfo(QSerialPort::ReadError,
+                                              QSerialPort::tr("Corrupted compressed data")));
+                return;
+            }
+            block = QByteArrayView(decompressBlock.constData(), size);
+        }
+        offset += QSerialPortLz4::HeaderSize + stored;
+        compressionStats.packedRead += QSerialPortLz4::HeaderSize + stored;
+        compressionStats.plainRead += size;
+
+        filterInbound(0, block);
+        if (compression == QSerialPort::NoCompression)
+            return;
+    }
+    decompressPending = input.sliced(offset).toByteArray();
+}
+
+/*
+    Removes the marks that the driver inserts with PARMRK from \a data in
+    place, and records the line errors they stand for: 0xFF 0x00 0x00 is
+    a break, 0xFF 0x00 c is the character c received with a parity or
+    framing error, and 0xFF 0xFF is a 0xFF data byte. A mark split over
+    two reads is completed by the next call. Returns the size of the data
+    left.
+*/
+qint64 QSerialPortPrivate::unmarkLineErrors(char *data, qint64 size)
+{
+    enum { Data, Escaped, Marked };
+
+    char *out = data;
+    const char *p = data;
+    const char *const end = data + size;
+    while (p < end) {
+        if (lineMarkState == Data) {
+            const void *mark = ::memchr(p, 0xff, end - p);
+            const char *runEnd = mark ? static_cast<const char *>(mark) : end;
+            if (out != p)
+                ::memmove(out, p, runEnd - p);
+            out += runEnd - p;
+            p = runEnd;
+            if (mark) {
+                ++p;
+                lineMarkState = Escaped;
+            }
+        } else if (lineMarkState == Escaped) {
+            if (*p == 0) {
+                ++p;
+                lineMarkState = Marked;
+            } else {
+                // 0xFF 0xFF; anything else is not a mark, keep the 0xFF
+                if (quint8(*p) == 0xff)
+                    ++p;
+                *out++ = char(0xff);
+                lineMarkState = Data;
+            }
+        } else {
+            const char c = *p++;
+            const qint64 position = lineStreamPosition + (out - data);
+            if (c == 0 && !nineBitMode) {
+                lineErrors.append({ QSerialPort::BreakCondition, position });
+            } else {
+                lineErrors.append({ QSerialPort::CharacterError, position });
+                *out++ = c;
+            }
+            lineErrorsPending = true;
+            lineMarkState = Data;
+        }
+    }
+
+    lineStreamPosition += out - data;
+    return out - data;
+}
+
+void QSerialPortPrivate::emitLineErrors()
+{
+    Q_Q(QSerialPort);
+    if (std::exchange(lineErrorsPending, false))
+        emit q->lineErrorsReceived();
+}
+
+// Time the UART takes to send one character, in nanoseconds
+qint64 QSerialPortPrivate::characterTime() const
+{
+    int halfBits = 2 * (1 + dataBits.value());
+    if (parity.value() != QSerialPort::NoParity)
+        halfBits += 2;
+    switch (stopBits.value()) {
+    case QSerialPort::OneAndHalfStop:
+        halfBits += 3;
+        break;
+    case QSerialPort::TwoStop:
+        halfBits += 4;
+        break;
+    default:
+        halfBits += 2;
+        break;
+    }
+    return halfBits * 500000000LL / qMax(outputBaudRate, 1);
+}
+
+/*
+    Returns the estimated time in nanoseconds until the data written so far
+    has left the UART, 0 if it has, or -1 if the driver cannot tell.
+*/
+qint64 QSerialPortPrivate::transmitTimeRemaining()
+{
+    Q_Q(QSerialPort);
+
+    std::optional<bool> transmitterEmpty;
+    const qint64 queued = backend->transmitQueueSize(&transmitterEmpty);
+    if (queued < 0)
+        return -1;
+
+    const qint64 pending = q->bytesToWrite() + queued;
+    if (pending > 0 || transmitterEmpty == false) {
+        transmitDrainDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
+        return qMax(pending, qint64(1)) * characterTime();
+    }
+    if (transmitterEmpty == true)
+        return 0;
+
+    // Without the state of the UART, allow for the character in its shift
+    // register once the queue of the driver is empty
+    if (transmitDrainDeadline.isForever())
+        transmitDrainDeadline = QDeadlineTimer(std::chrono::nanoseconds(characterTime()));
+    return transmitDrainDeadline.remainingTimeNSecs();
+}
+
+/*
+    Emits transmitComplete() once the data handed over to the driver has
+    left the UART, checking again after the estimated time until then.
+    Does nothing unless the signal is connected.
+*/
+void QSerialPortPrivate::scheduleTransmitCheck()
+{
+    Q_Q(QSerialPort);
+
+    static const QMetaMethod signal = QMetaMethod::fromSignal(&QSerialPort::transmitComplete);
+    if (!q->isSignalConnected(signal))
+        return;
+
+    const qint64 remaining = transmitTimeRemaining();
+    if (remaining < 0)
+        return;
+    if (remaining == 0) {
+        emit q->transmitComplete();
+        return;
+    }
+
+    if (!transmitCheckTimer) {
+        transmitCheckTimer = new QTimer(q);
+        transmitCheckTimer->setSingleShot(true);
+        transmitCheckTimer->setTimerType(Qt::PreciseTimer);
+        QObjectPrivate::connect(transmitCheckTimer, &QTimer::timeout,
+                                this, &QSerialPortPrivate::scheduleTransmitCheck);
+    }
+    transmitCheckTimer->start(std::chrono::ceil<std::chrono::milliseconds>(
+                                  std::chrono::nanoseconds(remaining)));
+}
+
+/*
+    Starts writing data that was placed into the write buffer directly.
+*/
+bool QSerialPortPrivate::startWriteBuffer()
+{
+    return backend->queueWrite(nullptr, 0) >= 0;
+}
+
+void QSerialPortPrivate::captureRecord(quint8 type, const char *data, qint64 size)
+{
+    if (!captureDevice)
+        return;
+
+    uchar header[QSerialPortCapture::RecordHeaderSize] = {};
+    header[0] = type;
+    qToLittleEndian<quint32>(quint32(size), header + 4);
+    qToLittleEndian<qint64>(captureTimer.nsecsElapsed(), header + 8);
+
+    static const char padding[8] = {};
+    captureDevice->write(reinterpret_cast<const char *>(header), sizeof(header));
+    captureDevice->write(data, size);
+    captureDevice->write(padding, QSerialPortCapture::recordSize(size)
+                         - QSerialPortCapture::RecordHeaderSize - size);
+}
+
+void QSerialPortPrivate::captureSettings()
+{
+    if (!captureDevice)
+        return;
+
+    uchar settings[QSerialPortCapture::SettingsSize] = {};
+    qToLittleEndian<qint32>(inputBaudRate, settings);
+    qToLittleEndian<qint32>(outputBaudRate, settings + 4);
+    settings[8] = uchar(dataBits.valueBypassingBindings());
+    settings[9] = uchar(parity.valueBypassingBindings());
+    settings[10] = uchar(stopBits.valueBypassingBindings());
+    settings[11] = uchar(flowControl.valueBypassingBindings());
+    captureRecord(QSerialPortCapture::SettingsRecord,
+                  reinterpret_cast<const char *>(settings), sizeof(settings));
+}
+
+void QSerialPortPrivate::recordWakeupToRead(qint64 nsecs)
+{
+    QMutexLocker locker(&latencyMutex);
+    if (latency.reads == 0 || nsecs < latency.wakeupToReadMinimum)
+        latency.wakeupToReadMinimum = nsecs;
+    latency.wakeupToReadMaximum = qMax(latency.wakeupToReadMaximum, nsecs);
+    latency.wakeupToReadTotal += nsecs;
+    ++latency.reads;
+}
+
+void QSerialPortPrivate::recordReadToDeliver(qint64 nsecs)
+{
+    QMutexLocker locker(&latencyMutex);
+    if (latency.deliveries == 0 || nsecs < latency.readToDeliverMinimum)
+        latency.readToDeliverMinimum = nsecs;
+    latency.readToDeliverMaximum = qMax(latency.readToDeliverMaximum, nsecs);
+    latency.readToDeliverTotal += nsecs;
+    ++latency.deliveries;
+}
+
+bool QSerialPortPrivate::prepareOpen(QIODevice::OpenMode mode)
+{
+    Q_Q(QSerialPort);
+
+    if (q->isOpen()) {
+        setError(QSerialPortErrorInfo(QSerialPort::OpenError));
+        return false;
+    }
+
+    // Define while not supported modes.
+    static const QIODevice::OpenMode unsupportedModes = QIODevice::Append | QIODevice::Truncate
+            | QIODevice::Text | QIODevice::Unbuffered;
+    if ((mode & unsupportedModes) || mode == QIODevice::NotOpen) {
+        setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                      QSerialPort::tr("Unsupported open mode")));
+        return false;
+    }
+
+    q->clearError();
+    backend = QSerialPortBackend::create(q->portName());
+    backend->d = this;
+    return true;
+}
+
+bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
+{
+    return openDevice(mode) && startNotifications(mode);
+}
+
+void QSerialPortPrivate::completeOpen(QIODevice::OpenMode mode)
+{
+    Q_Q(QSerialPort);
+
+    {
+        QMutexLocker locker(&latencyMutex);
+        latency = QSerialPortLatencyStatistics();
+    }
+    lineMarkState = 0;
+    lineStreamPosition = 0;
+    lineErrors.clear();
+    lineErrorsPending = false;
+#if defined(Q_OS_UNIX)
+    // Reads go straight into the buffer of the caller, see readBlocking()
+    if (blockingModeActive)
+        mode |= QIODevice::Unbuffered;
+#endif
+    q->QIODevice::open(mode);
+    captureSettings();
+}
+
+/*
+    Reads from a backend that moves the data with read() and write() once
+    the event loop runs, see QSerialPortBackend::readyRead(). A read left
+    scheduled when the serial port is closed is dropped.
+*/
+void QSerialPortPrivate::scheduleBackendRead()
+{
+    Q_Q(QSerialPort);
+
+    if (backendReadScheduled)
+        return;
+    backendReadScheduled = true;
+    QMetaObject::invokeMethod(q, [this]() {
+        if (std::exchange(backendReadScheduled, false))
+            backend->readNotification();
+    }, Qt::QueuedConnection);
+}
+
+void QSerialPortPrivate::scheduleBackendWrite()
+{
+    Q_Q(QSerialPort);
+
+    if (backendWriteScheduled)
+        return;
+    backendWriteScheduled = true;
+    QMetaObject::invokeMethod(q, [this]() {
+        if (std::exchange(backendWriteScheduled, false))
+            backend->writeNotification();
+    }, Qt::QueuedConnection);
+}
+
+void QSerialPortPrivate::checkReadBufferWatermarks()
+{
+    Q_Q(QSerialPort);
+
+    if (!readThrottled) {
+        if (readBufferHighWatermark <= 0 || buffer.size() < readBufferHighWatermark)
+            return;
+        readThrottled = true;
+        backend->throttleRead(true);
+        emit q->readBufferNearlyFull();
+    } else if (readBufferHighWatermark <= 0 || buffer.size() <= readBufferLowWatermark) {
+        readThrottled = false;
+        backend->throttleRead(false);
+    }
+}
+
+void QSerialPortPrivate::checkWriteBufferDrained()
+{
+    Q_Q(QSerialPort);
+
+    if (writeBufferFullEmitted && writeBuffer.size() <= writeBufferMaxSize / 2) {
+        writeBufferFullEmitted = false;
+        // A compressed block held back is retried from the event loop;
+        // writing it here could fill the buffer again before the signal,
+        // or nest waiting for the write under starting it
+        if (compressionFlushDeferred) {
+            compressionFlushDeferred = false;
+            startCompressionFlushTimer(0);
+        }
+        emit q->writeBufferDrained();
+    }
+}
+
+/*!
+    \class QSerialPort
+
+    \brief Provides functions to access serial ports.
+
+    \reentrant
+    \ingroup serialport-main
+    \inmodule QtSerialPort
+    \since 5.1
+
+    You can get information about the available serial ports using the
+    QSerialPortInfo helper class, which allows an enumeration of all the serial
+    ports in the system. This is useful to obtain the correct name of the
+    serial port you want to use. You can pass an object
+    of the helper class as an argument to the setPort() or setPortName()
+    methods to assign the desired serial device.
+
+    After setting the port, you can open it in read-only (r/o), write-only
+    (w/o), or read-write (r/w) mode using the open() method.
+
+    \note The serial port is always opened with exclusive access
+    (that is, no other process or thread can access an already opened serial port).
+
+    Use the close() method to close the port and cancel the I/O operations.
+
+    Having successfully opened, QSerialPort tries to determine the current
+    configuration of the port and initializes itself. You can reconfigure the
+    port to the desired setting using the setBaudRate(), setDataBits(),
+    setParity(), setStopBits(), and setFlowControl() methods.
+
+    There are a couple of properties to work with the pinout signals namely:
+    QSerialPort::dataTerminalReady, QSerialPort::requestToSend. It is also
+    possible to use the pinoutSignals() method to query the current pinout
+    signals set.
+
+    Once you know that the ports are ready to read or write, you can
+    use the read() or write() methods. Alternatively the
+    readLine() and readAll() convenience methods can also be invoked.
+    If not all the data is read at once, the remaining data will
+    be available for later as new incoming data is appended to the
+    QSerialPort's internal read buffer. You can limit the size of the read
+    buffer using setReadBufferSize().
+
+    QSerialPort provides a set of functions that suspend the
+    calling thread until certain signals are emitted. These functions
+    can be used to implement blocking serial ports:
+
+    \list
+
+    \li waitForReadyRead() blocks calls until new data is available for
+    reading.
+
+    \li waitForBytesWritten() blocks calls until one payload of data has
+    been written to the serial port.
+
+    \endlist
+
+    See the following example:
+
+    \code
+     int numRead = 0, numReadTotal = 0;
+     char buffer[50];
+
+     for (;;) {
+         numRead  = serial.read(buffer, 50);
+
+         // Do whatever with the array
+
+         numReadTotal += numRead;
+         if (numRead == 0 && !serial.waitForReadyRead())
+             break;
+     }
+    \endcode
+
+    If \l{QIODevice::}{waitForReadyRead()} returns \c false, the
+    connection has been closed or an error has occurred.
+
+    If an error occurs at any point in time, QSerialPort will emit the
+    errorOccurred() signal. You can also call error() to find the type of
+    error that occurred last.
+
+    Programming with a blocking serial port is radically different from
+    programming with a non-blocking serial port. A blocking serial port
+    does not require an event loop and typically leads to simpler code.
+    However, in a GUI application, blocking serial port should only be
+    used in non-GUI threads, to avoid freezing the user interface.
+
+    For more details about these approaches, refer to the
+    \l {Qt Serial Port Examples}{example} applications.
+
+    The QSerialPort class can also be used with QTextStream and QDataStream's
+    stream operators (operator<<() and operator>>()). There is one issue to be
+    aware of, though: make sure that enough data is available before attempting
+    to read by using the operator>>() overloaded operator.
+
+    \sa QSerialPortInfo
+*/
+
+/*!
+    \enum QSerialPort::Direction
+
+    This enum describes the possible directions of the data transmission.
+
+    \note This enumeration is used for setting the baud rate of the device
+    separately for each direction on some operating systems (for example,
+    POSIX-like).
+
+    \value Input            Input direction.
+    \value Output           Output direction.
+    \value AllDirections    Simultaneously in two directions.
+*/
+
+/*!
+    \enum QSerialPort::BaudRate
+
+    This enum describes the baud rate which the communication device operates
+    with.
+
+    \note Only the most common standard baud rates are listed in this enum.
+
+    \value Baud1200     1200 baud.
+    \value Baud2400     2400 baud.
+    \value Baud4800     4800 baud.
+    \value Baud9600     9600 baud.
+    \value Baud19200    19200 baud.
+    \value Baud38400    38400 baud.
+    \value Baud57600    57600 baud.
+    \value Baud115200   115200 baud.
+
+    \sa QSerialPort::baudRate
+*/
+
+/*!
+    \enum QSerialPort::DataBits
+
+    This enum describes the number of data bits used.
+
+    \value Data5            The number of data bits in each character is 5. It
+                            is used for Baudot code. It generally only makes
+                            sense with older equipment such as teleprinters.
+    \value Data6            The number of data bits in each character is 6. It
+                            is rarely used.
+    \value Data7            The number of data bits in each character is 7. It
+                            is used for true ASCII. It generally only makes
+                            sense with older equipment such as teleprinters.
+    \value Data8            The number of data bits in each character is 8. It
+                            is used for most kinds of data, as this size matches
+                            the size of a byte. It is almost universally used in
+                            newer applications.
+
+    \sa QSerialPort::dataBits
+*/
+
+/*!
+    \enum QSerialPort::Parity
+
+    This enum describes the parity scheme used.
+
+    \value NoParity         No parity bit it sent. This is the most common
+                            parity setting. Error detection is handled by the
+                            communication protocol.
+    \value EvenParity       The number of 1 bits in each character, including
+                            the parity bit, is always even.
+    \value OddParity        The number of 1 bits in each character, including
+                            the parity bit, is always odd. It ensures that at
+                            least one state transition occurs in each character.
+    \value SpaceParity      Space parity. The parity bit is sent in the space
+                            signal condition. It does not provide error
+                            detection information.
+    \value MarkParity       Mark parity. The parity bit is always set to the
+                            mark signal condition (logical 1). It does not
+                            provide error detection information.
+
+    \sa QSerialPort::parity
+*/
+
+/*!
+    \enum QSerialPort::StopBits
+
+    This enum describes the number of stop bits used.
+
+    \value OneStop          1 stop bit.
+    \value OneAndHalfStop   1.5 stop bits. This is only for the Windows platform.
+    \value TwoStop          2 stop bits.
+
+    \sa QSerialPort::stopBits
+*/
+
+/*!
+    \enum QSerialPort::FlowControl
+
+    This enum describes the flow control used.
+
+    \value NoFlowControl        No flow control.
+    \value HardwareControl      Hardware flow control (RTS/CTS).
+    \value SoftwareControl      Software flow control (XON/XOFF).
+
+    \sa QSerialPort::flowControl
+*/
+
+/*!
+    \enum QSerialPort::PinoutSignal
+
+    This enum describes the possible RS-232 pinout signals.
+
+    \value NoSignal                       No line active
+    \value DataTerminalReadySignal        DTR (Data Terminal Ready).
+    \value DataCarrierDetectSignal        DCD (Data Carrier Detect).
+    \value DataSetReadySignal             DSR (Data Set Ready).
+    \value RingIndicatorSignal            RNG (Ring Indicator).
+    \value RequestToSendSignal            RTS (Request To Send).
+    \value ClearToSendSignal              CTS (Clear To Send).
+    \value SecondaryTransmittedDataSignal STD (Secondary Transmitted Data).
+    \value SecondaryReceivedDataSignal    SRD (Secondary Received Data).
+
+    \sa pinoutSignals(), QSerialPort::dataTerminalReady,
+    QSerialPort::requestToSend
+*/
+
+/*!
+    \enum QSerialPort::SerialPortError
+
+    This enum describes the errors that may be contained by the
+    QSerialPort::error property.
+
+    \value NoError              No error occurred.
+
+    \value DeviceNotFoundError  An error occurred while attempting to
+                                open an non-existing device.
+
+    \value PermissionError      An error occurred while attempting to
+                                open an already opened device by another
+                                process or a user not having enough permission
+                                and credentials to open.
+
+    \value OpenError            An error occurred while attempting to open an
+                                already opened device in this object.
+
+    \value NotOpenError         This error occurs when an operation is executed
+                                that can only be successfully performed if the
+                                device is open. This value was introduced in
+                                QtSerialPort 5.2.
+
+    \value WriteError           An I/O error occurred while writing the data.
+
+    \value ReadError            An I/O error occurred while reading the data.
+
+    \value ResourceError        An I/O error occurred when a resource becomes
+                                unavailable, e.g. when the device is
+                                unexpectedly removed from the system.
+
+    \value UnsupportedOperationError The requested device operation is not
+                                supported or prohibited by the running operating
+                                system.
+
+    \value TimeoutError         A timeout error occurred. This value was
+                                introduced in QtSerialPort 5.2.
+
+    \value UnknownError         An unidentified error occurred.
+    \sa QSerialPort::error
+*/
+
+/*!
+    \enum QSerialPort::WriteBufferPolicy
+    \since 6.9
+
+    This enum describes what write() does when the size of the internal
+    write buffer is limited and the data does not fit into the buffer.
+
+    \value RejectWhenFull       Only the part of the data which fits into
+                                the buffer is accepted, and write() returns
+                                the number of bytes accepted.
+    \value BlockWhenFull        write() waits until the driver takes enough
+                                of the buffered data, but not longer than
+                                writeBufferTimeout() milliseconds. The number
+                                of bytes accepted until then is returned.
+    \value DropOldestWhenFull   The oldest buffered data that is not yet
+                                passed to the driver is discarded to make room
+                                for the new data, and write() accepts all of
+                                the data.
+
+    \sa setWriteBufferMaxSize(), setWriteBufferPolicy()
+*/
+
+
+
+/*!
+    Constructs a new serial port object with the given \a parent.
+*/
+QSerialPort::QSerialPort(QObject *parent)
+    : QIODevice(*new QSerialPortPrivate, parent)
+{
+}
+
+/*!
+    Constructs a new serial port object with the given \a parent
+    to represent the serial port with the specified \a name.
+
+    The name should have a specific format; see the setPort() method.
+*/
+QSerialPort::QSerialPort(const QString &name, QObject *parent)
+    : QIODevice(*new QSerialPortPrivate, parent)
+{
+    setPortName(name);
+}
+
+/*!
+    Constructs a new serial port object with the given \a parent
+    to represent the serial port with the specified helper class
+    \a serialPortInfo.
+*/
+QSerialPort::QSerialPort(const QSerialPortInfo &serialPortInfo, QObject *parent)
+    : QIODevice(*new QSerialPortPrivate, parent)
+{
+    setPort(serialPortInfo);
+}
+
+/*!
+    Closes the serial port, if necessary, and then destroys object.
+*/
+QSerialPort::~QSerialPort()
+{
+    /**/
+    if (isOpen())
+        close();
+}
+
+/*!
+    Sets the \a name of the serial port.
+
+    The name of the serial port can be passed as either a short name or
+    the long system location if necessary.
+
+    Since Qt 6.9, a name of the form \c{scheme://location} selects a
+    transport that is used instead of a native serial port. The
+    \c{loopback://} transport, which returns all written data as read data
+    without any system calls, is always available.
+
+    On Unix, \c{rfc2217://host:port} opens a serial port on a network
+    device server that implements the Telnet COM port control option of
+    RFC 2217. The port defaults to 23. Settings, the DTR and RTS lines and
+    the break state are sent to the device server, and pinoutSignals()
+    reports the modem state that the server notifies. A lost connection
+    is reported as ResourceError.
+
+    \sa portName(), QSerialPortInfo
+*/
+void QSerialPort::setPortName(const QString &name)
+{
+    Q_D(QSerialPort);
+    d->systemLocation = QSerialPortInfoPrivate::portNameToSystemLocation(name);
+}
+
+/*!
+    Sets the port stored in the serial port info instance \a serialPortInfo.
+
+    \sa portName(), QSerialPortInfo
+*/
+void QSerialPort::setPort(const QSerialPortInfo &serialPortInfo)
+{
+    Q_D(QSerialPort);
+    d->systemLocation = serialPortInfo.systemLocation();
+}
+
+/*!
+    Returns the name set by setPort() or passed to the QSerialPort constructor.
+    This name is short, i.e. it is extracted and converted from the internal
+    variable system location of the device. The conversion algorithm is
+    platform specific:
+    \table
+    \header
+        \li Platform
+        \li Brief Description
+    \row
+        \li Windows
+        \li Removes the prefix "\\\\.\\" or "//./" from the system location
+           and returns the remainder of the string.
+    \row
+        \li Unix, BSD
+        \li Removes the prefix "/dev/" from the system location
+           and returns the remainder of the string.
+    \endtable
+
+    \sa setPort(), QSerialPortInfo::portName()
+*/
+QString QSerialPort::portName() const
+{
+    Q_D(const QSerialPort);
+    return QSerialPortInfoPrivate::portNameFromSystemLocation(d->systemLocation);
+}
+
+/*!
+    \reimp
+
+    Opens the serial port using OpenMode \a mode, and then returns \c true if
+    successful; otherwise returns \c false and sets an error code which can be
+    obtained by calling the error() method.
+
+    \note The method returns \c false if opening the port is successful, but could
+    not set any of the port settings successfully. In that case, the port is
+    closed automatically not to leave the port around with incorrect settings.
+
+    \warning The \a mode has to be QIODeviceBase::ReadOnly, QIODeviceBase::WriteOnly,
+    or QIODeviceBase::ReadWrite. Other modes are unsupported.
+
+    \sa QIODeviceBase::OpenMode, setPort()
+*/
+bool QSerialPort::open(OpenMode mode)
+{
+    Q_D(QSerialPort);
+
+    if (!d->prepareOpen(mode)
+            || !d->backend->openDevice(mode)
+            || !d->backend->startDevice(mode)) {
+        return false;
+    }
+
+    d->completeOpen(mode);
+    return true;
+}
+
+/*!
+    \since 6.9
+
+    Opens all \a serialPorts using OpenMode \a mode, each with the
+    settings that were set on it before, and returns \c true if all of
+    them could be opened.
+
+    Opening a port and applying its settings are blocking system calls,
+    which some drivers take tens of milliseconds to complete. This
+    function makes these calls in parallel on worker threads, up to
+    QThread::idealThreadCount() ports at a time, so that the time taken
+    grows with the slowest ports rather than the sum of all ports.
+    Everything that involves the event loop, and the signals about errors,
+    happen in the calling thread once the blocking part is done.
+
+    A port that can not be opened reports the error as open() does, and
+    does not prevent the other ports from being opened.
+
+    \note All \a serialPorts must belong to the calling thread.
+
+    \sa open()
+*/
+bool QSerialPort::openAll(const QList<QSerialPort *> &serialPorts, OpenMode mode)
+{
+    bool result = true;
+    QList<QSerialPortPrivate *> pending;
+
+    for (QSerialPort *serialPort : serialPorts) {
+        Q_ASSERT_X(serialPort->thread() == QThread::currentThread(), "QSerialPort::openAll",
+                   "The serial ports must belong to the calling thread");
+        QSerialPortPrivate *d = serialPort->d_func();
+        if (d->prepareOpen(mode))
+            pending.append(d);
+        else
+            result = false;
+    }
+
+    QList<bool> opened(pending.size(), false);
+    if (pending.size() == 1) {
+        opened[0] = pending.constFirst()->backend->openDevice(mode);
+    } else if (!pending.isEmpty()) {
+        // A thread per port would not scale to a large number of ports
+        QThreadPool pool;
+        pool.setMaxThreadCount(int(qMin(pending.size(), qsizetype(QThread::idealThreadCount()))));
+        for (qsizetype i = 0; i < pending.size(); ++i) {
+            QSerialPortPrivate *d = pending.at(i);
+            d->errorsDeferred = true;
+            bool *slot = opened.data() + i;
+            pool.start([d, mode, slot]() {
+                *slot = d->backend->openDevice(mode);
+            });
+        }
+        pool.waitForDone();
+    }
+
+    for (qsizetype i = 0; i < pending.size(); ++i) {
+        QSerialPortPrivate *d = pending.at(i);
+        d->errorsDeferred = false;
+        const QList<QSerialPortErrorInfo> errors = std::exchange(d->deferredErrors, {});
+        for (const QSerialPortErrorInfo &error : errors)
+            d->setError(error);
+
+        if (opened.at(i) && d->backend->startDevice(mode))
+            d->completeOpen(mode);
+        else
+            result = false;
+    }
+
+    return result;
+}
+
+/*!
+    \reimp
+
+    \note The serial port has to be open before trying to close it; otherwise
+    sets the NotOpenError error code.
+
+    \sa QIODevice::close()
+*/
+void QSerialPort::close()
+{
+    Q_D(QSerialPort);
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        return;
+    }
+
+    // The last short block goes the way of the rest of the written data
+    d->flushCompression();
+    d->decompressPending.clear();
+    d->decompressFailed = false;
+    if (d->transmitCheckTimer)
+        d->transmitCheckTimer->stop();
+    d->transmitDrainDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
+
+    d->backend->close();
+    d->backendReadScheduled = false;
+    d->backendReadBlocked = false;
+    d->backendWriteScheduled = false;
+    d->isBreakEnabled.setValue(false);
+    d->writeBufferFullEmitted = false;
+    d->readThrottled = false;
+    QIODevice::close();
+}
+
+/*!
+    \property QSerialPort::baudRate
+    \brief the data baud rate for the desired direction
+
+    If the setting is successful or set before opening the port, returns \c true;
+    otherwise returns \c false and sets an error code which can be obtained by
+    accessing the value of the QSerialPort::error property. To set the baud
+    rate, use the enumeration QSerialPort::BaudRate or any positive qint32
+    value.
+
+    \note If the setting is set before opening the port, the actual serial port
+    setting is done automatically in the \l{QSerialPort::open()} method right
+    after that the opening of the port succeeds.
+
+    \warning Setting the AllDirections flag is supported on all platforms.
+    Windows supports only this mode.
+
+    \warning Returns equal baud rate in any direction on Windows.
+
+    The default value is Baud9600, i.e. 9600 bits per second.
+*/
+bool QSerialPort::setBaudRate(qint32 baudRate, Directions directions)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen() || d->backend->setBaudRate(baudRate, directions)) {
+        if (directions & QSerialPort::Input) {
+            if (d->inputBaudRate != baudRate)
+                d->inputBaudRate = baudRate;
+            else
+                directions &= ~QSerialPort::Input;
+        }
+
+        if (directions & QSerialPort::Output) {
+            if (d->outputBaudRate != baudRate)
+                d->outputBaudRate = baudRate;
+            else
+                directions &= ~QSerialPort::Output;
+        }
+
+        if (directions) {
+            d->captureSettings();
+            emit baudRateChanged(baudRate, directions);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+qint32 QSerialPort::baudRate(Directions directions) const
+{
+    Q_D(const QSerialPort);
+    if (directions == QSerialPort::AllDirections)
+        return d->inputBaudRate == d->outputBaudRate ?
+                    d->inputBaudRate : -1;
+    return directions & QSerialPort::Input ? d->inputBaudRate : d->outputBaudRate;
+}
+
+/*!
+    \fn void QSerialPort::baudRateChanged(qint32 baudRate, Directions directions)
+
+    This signal is emitted after the baud rate has been changed. The new baud
+    rate is passed as \a baudRate and directions as \a directions.
+
+    \sa QSerialPort::baudRate
+*/
+
+/*!
+    \property QSerialPort::dataBits
+    \brief the data bits in a frame
+
+    If the setting is successful or set before opening the port, returns
+    \c true; otherwise returns \c false and sets an error code which can be obtained
+    by accessing the value of the QSerialPort::error property.
+
+    \note If the setting is set before opening the port, the actual serial port
+    setting is done automatically in the \l{QSerialPort::open()} method right
+    after that the opening of the port succeeds.
+
+    The default value is Data8, i.e. 8 data bits.
+*/
+bool QSerialPort::setDataBits(DataBits dataBits)
+{
+    Q_D(QSerialPort);
+    d->dataBits.removeBindingUnlessInWrapper();
+    const auto currentDataBits = d->dataBits.valueBypassingBindings();
+    if (!isOpen() || d->backend->setDataBits(dataBits)) {
+        d->dataBits.setValueBypassingBindings(dataBits);
+        if (currentDataBits != dataBits) {
+            d->captureSettings();
+            d->dataBits.notify();
+            emit dataBitsChanged(dataBits);
+        }
+        return true;
+    }
+    return false;
+}
+
+QSerialPort::DataBits QSerialPort::dataBits() const
+{
+    Q_D(const QSerialPort);
+    return d->dataBits;
+}
+
+QBindable<QSerialPort::DataBits> QSerialPort::bindableDataBits()
+{
+    return &d_func()->dataBits;
+}
+
+/*!
+    \fn void QSerialPort::dataBitsChanged(DataBits dataBits)
+
+    This signal is emitted after the data bits in a frame has been changed. The
+    new data bits in a frame is passed as \a dataBits.
+
+    \sa QSerialPort::dataBits
+*/
+
+
+/*!
+    \property QSerialPort::parity
+    \brief the parity checking mode
+
+    If the setting is successful or set before opening the port, returns \c true;
+    otherwise returns \c false and sets an error code which can be obtained by
+    accessing the value of the QSerialPort::error property.
+
+    \note If the setting is set before opening the port, the actual serial port
+    setting is done automatically in the \l{QSerialPort::open()} method right
+    after that the opening of the port succeeds.
+
+    The default value is NoParity, i.e. no parity.
+*/
+bool QSerialPort::setParity(Parity parity)
+{
+    Q_D(QSerialPort);
+    d->parity.removeBindingUnlessInWrapper();
+    const auto currentParity = d->parity.valueBypassingBindings();
+    if (!isOpen() || d->backend->setParity(parity)) {
+        d->parity.setValueBypassingBindings(parity);
+        if (currentParity != parity) {
+            d->captureSettings();
+            d->parity.notify();
+            emit parityChanged(parity);
+        }
+        return true;
+    }
+    return false;
+}
+
+QSerialPort::Parity QSerialPort::parity() const
+{
+    Q_D(const QSerialPort);
+    return d->parity;
+}
+
+QBindable<QSerialPort::Parity> QSerialPort::bindableParity()
+{
+    return &d_func()->parity;
+}
+
+/*!
+    \fn void QSerialPort::parityChanged(Parity parity)
+
+    This signal is emitted after the parity checking mode has been changed. The
+    new parity checking mode is passed as \a parity.
+
+    \sa QSerialPort::parity
+*/
+
+/*!
+    \property QSerialPort::stopBits
+    \brief the number of stop bits in a frame
+
+    If the setting is successful or set before opening the port, returns \c true;
+    otherwise returns \c false and sets an error code which can be obtained by
+    accessing the value of the QSerialPort::error property.
+
+    \note If the setting is set before opening the port, the actual serial port
+    setting is done automatically in the \l{QSerialPort::open()} method right
+    after that the opening of the port succeeds.
+
+    The default value is OneStop, i.e. 1 stop bit.
+*/
+bool QSerialPort::setStopBits(StopBits stopBits)
+{
+    Q_D(QSerialPort);
+    d->stopBits.removeBindingUnlessInWrapper();
+    const auto currentStopBits = d->stopBits.valueBypassingBindings();
+    if (!isOpen() || d->backend->setStopBits(stopBits)) {
+        d->stopBits.setValueBypassingBindings(stopBits);
+        if (currentStopBits != stopBits) {
+            d->captureSettings();
+            d->stopBits.notify();
+            emit stopBitsChanged(stopBits);
+        }
+        return true;
+    }
+    return false;
+}
+
+QSerialPort::StopBits QSerialPort::stopBits() const
+{
+    Q_D(const QSerialPort);
+    return d->stopBits;
+}
+
+QBindable<QSerialPort::StopBits> QSerialPort::bindableStopBits(QT6_IMPL_NEW_OVERLOAD)
+{
+    return &d_func()->stopBits;
+}
+
+/*!
+    \fn void QSerialPort::stopBitsChanged(StopBits stopBits)
+
+    This signal is emitted after the number of stop bits in a frame has been
+    changed. The new number of stop bits in a frame is passed as \a stopBits.
+
+    \sa QSerialPort::stopBits
+*/
+
+/*!
+    \property QSerialPort::flowControl
+    \brief the desired flow control mode
+
+    If the setting is successful or set before opening the port, returns \c true;
+    otherwise returns \c false and sets an error code which can be obtained by
+    accessing the value of the QSerialPort::error property.
+
+    \note If the setting is set before opening the port, the actual serial port
+    setting is done automatically in the \l{QSerialPort::open()} method right
+    after that the opening of the port succeeds.
+
+    The default value is NoFlowControl, i.e. no flow control.
+*/
+bool QSerialPort::setFlowControl(FlowControl flowControl)
+{
+    Q_D(QSerialPort);
+    d->flowControl.removeBindingUnlessInWrapper();
+    const auto currentFlowControl = d->flowControl.valueBypassingBindings();
+    if (!isOpen() || d->backend->setFlowControl(flowControl)) {
+        d->flowControl.setValueBypassingBindings(flowControl);
+        if (currentFlowControl != flowControl) {
+            d->captureSettings();
+            d->flowControl.notify();
+            emit flowControlChanged(flowControl);
+        }
+        return true;
+    }
+    return false;
+}
+
+QSerialPort::FlowControl QSerialPort::flowControl() const
+{
+    Q_D(const QSerialPort);
+    return d->flowControl;
+}
+
+QBindable<QSerialPort::FlowControl> QSerialPort::bindableFlowControl()
+{
+    return &d_func()->flowControl;
+}
+
+/*!
+    \fn void QSerialPort::flowControlChanged(FlowControl flow)
+
+    This signal is emitted after the flow control mode has been changed. The
+    new flow control mode is passed as \a flow.
+
+    \sa QSerialPort::flowControl
+*/
+
+/*!
+    \property QSerialPort::dataTerminalReady
+    \brief the state (high or low) of the line signal DTR
+
+    Returns \c true on success, \c false otherwise.
+    If the flag is \c true then the DTR signal is set to high; otherwise low.
+
+    \note The serial port has to be open before trying to set or get this
+    property; otherwise \c false is returned and the error code is set to
+    NotOpenError.
+
+    \sa pinoutSignals()
+*/
+bool QSerialPort::setDataTerminalReady(bool set)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    const bool dataTerminalReady = isDataTerminalReady();
+    const bool retval = d->backend->setDataTerminalReady(set);
+    if (retval && (dataTerminalReady != set))
+        emit dataTerminalReadyChanged(set);
+
+    return retval;
+}
+
+bool QSerialPort::isDataTerminalReady()
+{
+    return pinoutSignals() & QSerialPort::DataTerminalReadySignal;
+}
+
+/*!
+    \fn void QSerialPort::dataTerminalReadyChanged(bool set)
+
+    This signal is emitted after the state (high or low) of the line signal DTR
+    has been changed. The new the state (high or low) of the line signal DTR is
+    passed as \a set.
+
+    \sa QSerialPort::dataTerminalReady
+*/
+
+/*!
+    \property QSerialPort::requestToSend
+    \brief the state (high or low) of the line signal RTS
+
+    Returns \c true on success, \c false otherwise.
+    If the flag is \c true then the RTS signal is set to high; otherwise low.
+
+    \note The serial port has to be open before trying to set or get this
+    property; otherwise \c false is returned and the error code is set to
+    NotOpenError.
+
+    \note An attempt to control the RTS signal in the HardwareControl mode
+    will fail with error code set to UnsupportedOperationError, because
+    the signal is automatically controlled by the driver.
+
+    \sa pinoutSignals()
+*/
+bool QSerialPort::setRequestToSend(bool set)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (d->flowControl == QSerialPort::HardwareControl) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError));
+        return false;
+    }
+
+    const bool requestToSend = isRequestToSend();
+    const bool retval = d->backend->setRequestToSend(set);
+    if (retval && (requestToSend != set))
+        emit requestToSendChanged(set);
+
+    return retval;
+}
+
+bool QSerialPort::isRequestToSend()
+{
+    return pinoutSignals() & QSerialPort::RequestToSendSignal;
+}
+
+/*!
+    \fn void QSerialPort::requestToSendChanged(bool set)
+
+    This signal is emitted after the state (high or low) of the line signal RTS
+    has been changed. The new the state (high or low) of the line signal RTS is
+    passed as \a set.
+
+    \sa QSerialPort::requestToSend
+*/
+
+/*!
+    Returns the state of the line signals in a bitmap format.
+
+    From this result, it is possible to allocate the state of the
+    desired signal by applying a mask "AND", where the mask is
+    the desired enumeration value from QSerialPort::PinoutSignals.
+
+    \note This method performs a system call, thus ensuring that the line signal
+    states are returned properly. This is necessary when the underlying
+    operating systems cannot provide proper notifications about the changes.
+
+    \note The serial port has to be open before trying to get the pinout
+    signals; otherwise returns NoSignal and sets the NotOpenError error code.
+
+    \sa QSerialPort::dataTerminalReady, QSerialPort::requestToSend
+*/
+QSerialPort::PinoutSignals QSerialPort::pinoutSignals()
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return QSerialPort::NoSignal;
+    }
+
+    return d->backend->pinoutSignals();
+}
+
+/*!
+    \class QSerialPort::DriverQueueSizes
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief Holds the number of bytes queued in the driver of a serial port.
+
+    \sa QSerialPort::driverQueueSizes()
+*/
+
+/*!
+    \variable QSerialPort::DriverQueueSizes::input
+
+    The number of received bytes that the driver holds and that were not
+    read into the read buffer yet, or -1 if unknown.
+*/
+
+/*!
+    \variable QSerialPort::DriverQueueSizes::output
+
+    The number of bytes that the driver holds and that were not sent yet,
+    or -1 if unknown.
+*/
+
+/*!
+    \since 6.9
+
+    Returns the number of bytes queued in the driver of the serial port,
+    in both directions. Unlike bytesAvailable() and bytesToWrite(), which
+    count the internal buffers of QSerialPort, these are the bytes
+    received but not read yet, and written but not sent yet, as reported
+    by the driver: \c FIONREAD and \c TIOCOUTQ on Unix, and the
+    communications status on Windows. Add them to bytesAvailable() and
+    bytesToWrite() for the total amount of data under way.
+
+    The output queue does not include the characters in the FIFO of the
+    UART. Use waitForTransmitComplete() to wait for the data to be sent.
+
+    \note This function performs system calls every time it is called.
+
+    \note The serial port has to be open, and not use a QSerialPortBackend
+    selected by the port name; otherwise both sizes are -1 and the
+    NotOpenError or UnsupportedOperationError error code is set.
+
+    \sa bytesAvailable(), bytesToWrite(), waitForTransmitComplete()
+*/
+QSerialPort::DriverQueueSizes QSerialPort::driverQueueSizes()
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        return {};
+    }
+    return d->backend->driverQueueSizes();
+}
+
+/*!
+    This function writes as much as possible from the internal write
+    buffer to the underlying serial port without blocking. If any data
+    was written, this function returns \c true; otherwise returns \c false.
+
+    Call this function for sending the buffered data immediately to the serial
+    port. The number of bytes successfully written depends on the operating
+    system. In most cases, this function does not need to be called, because the
+    QSerialPort class will start sending data automatically once control is
+    returned to the event loop. In the absence of an event loop, call
+    waitForBytesWritten() instead.
+
+    \note The serial port has to be open before trying to flush any buffered
+    data; otherwise returns \c false and sets the NotOpenError error code.
+
+    \sa write(), waitForBytesWritten()
+*/
+bool QSerialPort::flush()
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (!d->flushCompression())
+        return false;
+    return d->backend->flushWriteBuffer();
+}
+
+/*!
+    Discards all characters from the output or input buffer, depending on
+    given directions \a directions. This includes clearing the internal class buffers and
+    the UART (driver) buffers. Also terminate pending read or write operations.
+    If successful, returns \c true; otherwise returns \c false.
+
+    \note The serial port has to be open before trying to clear any buffered
+    data; otherwise returns \c false and sets the NotOpenError error code.
+*/
+bool QSerialPort::clear(Directions directions)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (directions & Input) {
+        d->buffer.clear();
+        d->decompressPending.clear();
+        d->decompressFailed = false;
+        d->checkReadBufferWatermarks();
+    }
+    if (directions & Output) {
+        if (d->compressionFlushTimer)
+            d->compressionFlushTimer->stop();
+        d->compressPending.clear();
+        d->writeBuffer.clear();
+        d->checkWriteBufferDrained();
+    }
+    return d->backend->clear(directions);
+}
+
+/*!
+    \property QSerialPort::error
+    \brief the error status of the serial port
+
+    The I/O device status returns an error code. For example, if open()
+    returns \c false, or a read/write operation returns \c -1, this property can
+    be used to figure out the reason why the operation failed.
+
+    The error code is set to the default QSerialPort::NoError after a call to
+    clearError()
+*/
+QSerialPort::SerialPortError QSerialPort::error() const
+{
+    Q_D(const QSerialPort);
+    return d->error;
+}
+
+void QSerialPort::clearError()
+{
+    Q_D(QSerialPort);
+    d->setError(QSerialPortErrorInfo(QSerialPort::NoError));
+}
+
+QBindable<QSerialPort::SerialPortError> QSerialPort::bindableError() const
+{
+    return &d_func()->error;
+}
+
+/*!
+    \fn void QSerialPort::errorOccurred(SerialPortError error)
+    \since 5.8
 
-    The QSerialPort class can also be used with QTextStream and QDataStream's
-    stream operators (operator<<() and operator>>()). There is one issue to be
-    aware of, though: make sure that enough data is available before attempting
-    to read by using the operator>>() overloaded operator.
+    This signal is emitted when an error occurs in the serial port.
+    The specified \a error describes the type of error that occurred.
 
-    \sa QSerialPortInfo
+    \sa QSerialPort::error
 */
 
 /*!
-    \enum QSerialPort::Direction
-
-    This enum describes the possible directions of the data transmission.
+    Returns the size of the internal read buffer. This limits the
+    amount of data that the client can receive before calling the read()
+    or readAll() methods.
 
-    \note This enumeration is used for setting the baud rate of the device
-    separately for each direction on some operating systems (for example,
-    POSIX-like).
+    A read buffer size of \c 0 (the default) means that the buffer has
+    no size limit, ensuring that no data is lost.
 
-    \value Input            Input direction.
-    \value Output           Output direction.
-    \value AllDirections    Simultaneously in two directions.
+    \sa setReadBufferSize(), read()
 */
+qint64 QSerialPort::readBufferSize() const
+{
+    Q_D(const QSerialPort);
+    return d->readBufferMaxSize;
+}
 
 /*!
-    \enum QSerialPort::BaudRate
-
-    This enum describes the baud rate which the communication device operates
-    with.
+    Sets the size of QSerialPort's internal read buffer to be \a
+    size bytes.
 
-    \note Only the most common standard baud rates are listed in this enum.
+    If the buffer size is limited to a certain size, QSerialPort
+    will not buffer more than this size of data. The special case of a buffer
+    size of \c 0 means that the read buffer is unlimited and all
+    incoming data is buffered. This is the default.
 
-    \value Baud1200     1200 baud.
-    \value Baud2400     2400 baud.
-    \value Baud4800     4800 baud.
-    \value Baud9600     9600 baud.
-    \value Baud19200    19200 baud.
-    \value Baud38400    38400 baud.
-    \value Baud57600    57600 baud.
-    \value Baud115200   115200 baud.
+    This option is useful if the data is only read at certain points
+    in time (for instance in a real-time streaming application) or if the serial
+    port should be protected against receiving too much data, which may
+    eventually cause the application to run out of memory.
 
-    \sa QSerialPort::baudRate
+    \sa readBufferSize(), read()
 */
+void QSerialPort::setReadBufferSize(qint64 size)
+{
+    Q_D(QSerialPort);
+    d->readBufferMaxSize = size;
+    if (isReadable()) {
+        d->backend->resumeRead();
+    }
+}
 
 /*!
-    \enum QSerialPort::DataBits
+    \since 6.9
 
-    This enum describes the number of data bits used.
+    Starts recording the traffic of the serial port to \a device, which must
+    be open for writing. Passing \nullptr stops the recording. The serial
+    port does not take ownership of \a device.
 
-    \value Data5            The number of data bits in each character is 5. It
-                            is used for Baudot code. It generally only makes
-                            sense with older equipment such as teleprinters.
-    \value Data6            The number of data bits in each character is 6. It
-                            is rarely used.
-    \value Data7            The number of data bits in each character is 7. It
-                            is used for true ASCII. It generally only makes
-                            sense with older equipment such as teleprinters.
-    \value Data8            The number of data bits in each character is 8. It
-                            is used for most kinds of data, as this size matches
-                            the size of a byte. It is almost universally used in
-                            newer applications.
+    Every chunk of data read from or written to the driver is recorded
+    together with a monotonic timestamp, as well as the current settings
+    and every later change of them. The recording is written in a compact
+    binary format that QSerialPortReplay can read back, either in real time
+    or as fast as possible.
 
-    \sa QSerialPort::dataBits
+    \sa captureDevice(), QSerialPortReplay
 */
+void QSerialPort::setCaptureDevice(QIODevice *device)
+{
+    Q_D(QSerialPort);
 
-/*!
-    \enum QSerialPort::Parity
-
-    This enum describes the parity scheme used.
+    d->captureDevice = device;
+    if (!device)
+        return;
 
-    \value NoParity         No parity bit it sent. This is the most common
-                            parity setting. Error detection is handled by the
-                            communication protocol.
-    \value EvenParity       The number of 1 bits in each character, including
-                            the parity bit, is always even.
-    \value OddParity        The number of 1 bits in each character, including
-                            the parity bit, is always odd. It ensures that at
-                            least one state transition occurs in each character.
-    \value SpaceParity      Space parity. The parity bit is sent in the space
-                            signal condition. It does not provide error
-                            detection information.
-    \value MarkParity       Mark parity. The parity bit is always set to the
-                            mark signal condition (logical 1). It does not
-                            provide error detection information.
+    uchar header[QSerialPortCapture::FileHeaderSize];
+    ::memcpy(header, QSerialPortCapture::Magic, sizeof(QSerialPortCapture::Magic));
+    qToLittleEndian<quint16>(QSerialPortCapture::Version, header + sizeof(QSerialPortCapture::Magic));
+    device->write(reinterpret_cast<const char *>(header), sizeof(header));
 
-    \sa QSerialPort::parity
-*/
+    d->captureTimer.start();
+    d->captureSettings();
+}
 
 /*!
-    \enum QSerialPort::StopBits
-
-    This enum describes the number of stop bits used.
+    \since 6.9
 
-    \value OneStop          1 stop bit.
-    \value OneAndHalfStop   1.5 stop bits. This is only for the Windows platform.
-    \value TwoStop          2 stop bits.
+    Returns the device the traffic is recorded to, or \nullptr if the traffic
+    is not recorded.
 
-    \sa QSerialPort::stopBits
+    \sa setCaptureDevice()
 */
+QIODevice *QSerialPort::captureDevice() const
+{
+    Q_D(const QSerialPort);
+    return d->captureDevice;
+}
 
 /*!
-    \enum QSerialPort::FlowControl
+    \typealias QSerialPort::DataHandler
+    \since 6.9
 
-    This enum describes the flow control used.
-
-    \value NoFlowControl        No flow control.
-    \value HardwareControl      Hardware flow control (RTS/CTS).
-    \value SoftwareControl      Software flow control (XON/XOFF).
-
-    \sa QSerialPort::flowControl
+    Synonym for \c{std::function<void(QByteArrayView data)>}, the type of
+    the callable passed to setDataHandler().
 */
 
 /*!
-    \enum QSerialPort::PinoutSignal
+    \since 6.9
 
-    This enum describes the possible RS-232 pinout signals.
+    Passes the data received by the serial port to \a handler instead of
+    appending it to the read buffer. The handler is called with a view on
+    the bytes right after they are read from the driver, and readyRead()
+    is not emitted for them. This spares the signal emission and the
+    allocation of a QByteArray for every read, which adds up at high data
+    rates; the handler must parse or copy the data before it returns, as
+    the view does not outlive the call.
 
-    \value NoSignal                       No line active
-    \value DataTerminalReadySignal        DTR (Data Terminal Ready).
-    \value DataCarrierDetectSignal        DCD (Data Carrier Detect).
-    \value DataSetReadySignal             DSR (Data Set Ready).
-    \value RingIndicatorSignal            RNG (Ring Indicator).
-    \value RequestToSendSignal            RTS (Request To Send).
-    \value ClearToSendSignal              CTS (Clear To Send).
-    \value SecondaryTransmittedDataSignal STD (Secondary Transmitted Data).
-    \value SecondaryReceivedDataSignal    SRD (Secondary Received Data).
+    Data that is in the read buffer already stays there and can still be
+    read with read() and readAll(). Passing an empty handler restores the
+    buffered delivery.
 
-    \sa pinoutSignals(), QSerialPort::dataTerminalReady,
-    QSerialPort::requestToSend
+    The handler is called in the thread of the serial port, also while
+    one of the waitFor functions is blocking. It must not call
+    setDataHandler() itself.
+
+    \sa readyRead()
 */
+void QSerialPort::setDataHandler(DataHandler handler)
+{
+    Q_D(QSerialPort);
+    d->dataHandler = std::move(handler);
+    if (isReadable() && d->isReadBufferBypassed()) {
+        // The read buffer size does not limit the handler, resume reading
+        d->backend->resumeRead();
+    }
+}
 
 /*!
-    \enum QSerialPort::SerialPortError
-
-    This enum describes the errors that may be contained by the
-    QSerialPort::error property.
+    \since 6.9
 
-    \value NoError              No error occurred.
+    Appends \a filter to the chain of filters of the serial port. The
+    received data passes the filters in the order in which they were
+    added, the first one receiving the data as read from the driver; the
+    written data passes them in the reverse order, the first one added
+    handing it over to the driver. See QSerialPortFilter for details.
 
-    \value DeviceNotFoundError  An error occurred while attempting to
-                                open an non-existing device.
+    With filters, a write() is taken whole or not at all. If a maximum
+    write buffer size is set, the buffer has to have room for the data
+    passed to write(), or be empty; what the filters make of the data is
+    then queued whole, even if it overshoots the maximum by what they add.
+    A write that does not fit returns 0 before it reaches the filters.
 
-    \value PermissionError      An error occurred while attempting to
-                                open an already opened device by another
-                                process or a user not having enough permission
-                                and credentials to open.
+    The serial port does not take ownership of \a filter, which must stay
+    alive until it is removed or the serial port is destroyed.
 
-    \value OpenError            An error occurred while attempting to open an
-                                already opened device in this object.
+    \sa removeFilter(), filters()
+*/
+void QSerialPort::addFilter(QSerialPortFilter *filter)
+{
+    Q_D(QSerialPort);
+    if (!filter || d->filters.contains(filter))
+        return;
+    d->filters.append(filter);
+}
 
-    \value NotOpenError         This error occurs when an operation is executed
-                                that can only be successfully performed if the
-                                device is open. This value was introduced in
-                                QtSerialPort 5.2.
+/*!
+    \since 6.9
 
-    \value WriteError           An I/O error occurred while writing the data.
+    Removes \a filter from the chain of filters of the serial port.
 
-    \value ReadError            An I/O error occurred while reading the data.
+    \sa addFilter()
+*/
+void QSerialPort::removeFilter(QSerialPortFilter *filter)
+{
+    Q_D(QSerialPort);
+    d->filters.removeOne(filter);
+}
 
-    \value ResourceError        An I/O error occurred when a resource becomes
-                                unavailable, e.g. when the device is
-                                unexpectedly removed from the system.
+/*!
+    \since 6.9
 
-    \value UnsupportedOperationError The requested device operation is not
-                                supported or prohibited by the running operating
-                                system.
+    Returns the filters of the serial port, in the order in which they
+    process the received data.
 
-    \value TimeoutError         A timeout error occurred. This value was
-                                introduced in QtSerialPort 5.2.
+    \sa addFilter()
+*/
+QList<QSerialPortFilter *> QSerialPort::filters() const
+{
+    Q_D(const QSerialPort);
+    return d->filters;
+}
 
-    \value UnknownError         An unidentified error occurred.
-    \sa QSerialPort::error
+/*!
+    \enum QSerialPort::Framing
+    \since 6.9
+
+    This enum describes the framings that setFraming() can apply to the
+    data of the serial port.
+
+    \value NoFraming The data is a plain byte stream.
+    \value SlipFraming Frames are delimited and escaped as in the Serial
+            Line Internet Protocol (SLIP) of RFC 1055.
+    \value CobsFraming Frames are encoded with Consistent Overhead Byte
+            Stuffing (COBS) and delimited by zero bytes.
+    \value HdlcFraming Frames are delimited by 0x7E flags and escaped with
+            0x7D as in the asynchronous HDLC framing of RFC 1662. No frame
+            check sequence is added or verified.
+
+    \sa setFraming(), writeFrame(), frameReceived()
 */
 
+/*!
+    \since 6.9
 
+    Decodes the data received by the serial port with \a framing and
+    emits frameReceived() for every complete frame, instead of appending
+    the data to the read buffer. The decoder works incrementally on the
+    bytes as they are read from the driver, so frames that span several
+    reads are reassembled without buffering the stream. Empty frames,
+    frames cut short by a delimiter or an abort sequence, and frames
+    larger than 1 MiB are dropped.
 
-/*!
-    Constructs a new serial port object with the given \a parent.
+    Data that is in the read buffer already stays there. A data handler
+    set with setDataHandler() still receives the bytes before they are
+    decoded. Passing \l NoFraming restores the buffered delivery.
+
+    Changing the framing discards a partially received frame.
+
+    \sa framing(), writeFrame()
 */
-QSerialPort::QSerialPort(QObject *parent)
-    : QIODevice(*new QSerialPortPrivate, parent)
+void QSerialPort::setFraming(Framing framing)
 {
+    Q_D(QSerialPort);
+    d->frameCodec.reset(framing);
+    if (isReadable() && d->isReadBufferBypassed()) {
+        d->backend->resumeRead();
+    }
 }
 
 /*!
-    Constructs a new serial port object with the given \a parent
-    to represent the serial port with the specified \a name.
+    \since 6.9
 
-    The name should have a specific format; see the setPort() method.
+    Returns the framing of the data of the serial port.
+
+    \sa setFraming()
 */
-QSerialPort::QSerialPort(const QString &name, QObject *parent)
-    : QIODevice(*new QSerialPortPrivate, parent)
+QSerialPort::Framing QSerialPort::framing() const
 {
-    setPortName(name);
+    Q_D(const QSerialPort);
+    return d->frameCodec.framing();
 }
 
 /*!
-    Constructs a new serial port object with the given \a parent
-    to represent the serial port with the specified helper class
-    \a serialPortInfo.
+    \since 6.9
+
+    Encodes \a frame with the framing set by setFraming(), followed by the
+    check sequence selected with setFrameCheck(), and writes it to the
+    serial port. The frame is encoded straight into the write buffer,
+    unless a maximum write buffer size is set, immediate writes are
+    enabled, filters are installed or compression is set, in which case
+    it is encoded first.
+
+    The frame is queued whole or not at all. With a maximum write buffer
+    size, it is only queued if the buffer has room for all of it, or is
+    empty. No policy drops a part of it, and BlockWhenFull waits for the
+    room. Only a later write() with DropOldestWhenFull can still drop the
+    head of the queued data.
+
+    Returns the size of \a frame, 0 if the write buffer had no room for
+    it, or -1 if an error occurred.
+
+    \sa setFraming(), setFrameCheck(), frameReceived()
 */
-QSerialPort::QSerialPort(const QSerialPortInfo &serialPortInfo, QObject *parent)
-    : QIODevice(*new QSerialPortPrivate, parent)
+qint64 QSerialPort::writeFrame(QByteArrayView frame)
 {
-    setPort(serialPortInfo);
+    Q_D(QSerialPort);
+
+    const Framing mode = d->frameCodec.framing();
+    if (mode == NoFraming) {
+        qWarning("QSerialPort::writeFrame: no framing set");
+        return -1;
+    }
+    if (!isWritable()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        return -1;
+    }
+
+    const qint64 maximumSize = d->frameCodec.maximumEncodedSize(frame.size());
+    if (d->writeBufferMaxSize > 0 || d->immediateWrite || !d->filters.isEmpty()
+            || d->compression != NoCompression) {
+        QByteArray encoded(maximumSize, Qt::Uninitialized);
+        encoded.truncate(d->frameCodec.encode(frame, encoded.data()));
+        const qint64 written = d->writeWhole(encoded.constData(), encoded.size());
+        if (written <= 0)
+            return written;
+        return frame.size();
+    }
+
+    char *out = d->writeBuffer.reserve(maximumSize);
+    d->writeBuffer.chop(maximumSize - d->frameCodec.encode(frame, out));
+    return d->startWriteBuffer() ? frame.size() : qint64(-1);
 }
 
 /*!
-    Closes the serial port, if necessary, and then destroys object.
+    \enum QSerialPort::FrameCheck
+    \since 6.9
+
+    This enum describes the check sequences that setFrameCheck() can add
+    to the frames.
+
+    \value NoFrameCheck No check sequence is used.
+    \value Crc16ModbusCheck CRC-16/MODBUS: polynomial 0x8005, reflected,
+            initial value 0xFFFF, appended least significant byte first.
+    \value Crc16CcittCheck CRC-16/CCITT-FALSE: polynomial 0x1021, initial
+            value 0xFFFF, appended most significant byte first.
+    \value Crc32Check CRC-32 as used by Ethernet and zlib: polynomial
+            0x04C11DB7, reflected, initial value and final XOR 0xFFFFFFFF,
+            appended least significant byte first.
+
+    \sa setFrameCheck()
 */
-QSerialPort::~QSerialPort()
-{
-    /**/
-    if (isOpen())
-        close();
-}
 
 /*!
-    Sets the \a name of the serial port.
+    \since 6.9
 
-    The name of the serial port can be passed as either a short name or
-    the long system location if necessary.
+    Sets the check sequence of the frames to \a check. writeFrame()
+    appends it to every frame before encoding, and the decoder verifies
+    and strips it from every frame it receives. Frames with a wrong check
+    sequence are dropped and counted in frameCheckErrorCount(); they are
+    never emitted through frameReceived().
 
-    \sa portName(), QSerialPortInfo
+    The check sequence is computed eight bytes at a time with lookup
+    tables, as the frame is assembled.
+
+    Setting the frame check discards a partially received frame and
+    resets the error count. It has no effect without a framing.
+
+    \sa frameCheck(), setFraming()
 */
-void QSerialPort::setPortName(const QString &name)
+void QSerialPort::setFrameCheck(FrameCheck check)
 {
     Q_D(QSerialPort);
-    d->systemLocation = QSerialPortInfoPrivate::portNameToSystemLocation(name);
+    d->frameCodec.setFrameCheck(check);
 }
 
 /*!
-    Sets the port stored in the serial port info instance \a serialPortInfo.
+    \since 6.9
 
-    \sa portName(), QSerialPortInfo
+    Returns the check sequence of the frames.
+
+    \sa setFrameCheck()
 */
-void QSerialPort::setPort(const QSerialPortInfo &serialPortInfo)
+QSerialPort::FrameCheck QSerialPort::frameCheck() const
 {
-    Q_D(QSerialPort);
-    d->systemLocation = serialPortInfo.systemLocation();
+    Q_D(const QSerialPort);
+    return d->frameCodec.frameCheck();
 }
 
 /*!
-    Returns the name set by setPort() or passed to the QSerialPort constructor.
-    This name is short, i.e. it is extracted and converted from the internal
-    variable system location of the device. The conversion algorithm is
-    platform specific:
-    \table
-    \header
-        \li Platform
-        \li Brief Description
-    \row
-        \li Windows
-        \li Removes the prefix "\\\\.\\" or "//./" from the system location
-           and returns the remainder of the string.
-    \row
-        \li Unix, BSD
-        \li Removes the prefix "/dev/" from the system location
-           and returns the remainder of the string.
-    \endtable
+    \since 6.9
 
-    \sa setPort(), QSerialPortInfo::portName()
+    Returns the number of received frames that were dropped because their
+    check sequence was wrong or missing.
+
+    \sa setFrameCheck(), resetFrameCheckErrorCount()
 */
-QString QSerialPort::portName() const
+qint64 QSerialPort::frameCheckErrorCount() const
 {
     Q_D(const QSerialPort);
-    return QSerialPortInfoPrivate::portNameFromSystemLocation(d->systemLocation);
+    return d->frameCodec.frameCheckErrorCount();
 }
 
 /*!
-    \reimp
+    \since 6.9
 
-    Opens the serial port using OpenMode \a mode, and then returns \c true if
-    successful; otherwise returns \c false and sets an error code which can be
-    obtained by calling the error() method.
+    Resets the number of frames dropped because of a wrong check sequence.
 
-    \note The method returns \c false if opening the port is successful, but could
-    not set any of the port settings successfully. In that case, the port is
-    closed automatically not to leave the port around with incorrect settings.
+    \sa frameCheckErrorCount()
+*/
+void QSerialPort::resetFrameCheckErrorCount()
+{
+    Q_D(QSerialPort);
+    d->frameCodec.resetFrameCheckErrorCount();
+}
 
-    \warning The \a mode has to be QIODeviceBase::ReadOnly, QIODeviceBase::WriteOnly,
-    or QIODeviceBase::ReadWrite. Other modes are unsupported.
+/*!
+    \enum QSerialPort::Compression
+    \since 6.9
 
-    \sa QIODeviceBase::OpenMode, setPort()
+    This enum describes the compression that setCompression() can apply to
+    the data of the serial port.
+
+    \value NoCompression The data is sent and received as it is.
+    \value Lz4Compression The data is sent in blocks of up to 4096 bytes,
+            compressed in the LZ4 block format. Every block is preceded by
+            a four byte header holding its stored size and its uncompressed
+            size, both 16-bit little endian; a block that does not get
+            smaller is stored uncompressed, with both sizes equal.
+
+    \sa setCompression()
 */
-bool QSerialPort::open(OpenMode mode)
+
+/*!
+    \since 6.9
+
+    Sets the compression of the data of the serial port to \a compression.
+
+    The compression sits below the filters added with addFilter(): the
+    written data passes the filters first and is compressed afterwards,
+    and the received data is decompressed before it reaches the filters,
+    the data handler, the frame decoder or the read buffer. The
+    application reads and writes uncompressed data as before.
+
+    The written data is collected into blocks, and every full block is
+    compressed and written right away. The data of a block that is not
+    full yet is written once the flush timeout set by
+    setCompressionFlushTimeout() has passed, or when flush(),
+    waitForBytesWritten() or close() is called. bytesToWrite() includes
+    that data.
+
+    With a bounded write buffer, see setWriteBufferMaxSize(), every block
+    is queued whole or not at all, and no policy drops a part of a queued
+    block. A write takes the data up to the first block that does not fit
+    and returns the number of bytes taken; a block that does not fit with
+    DropOldestWhenFull is refused like with RejectWhenFull.
+
+    The compression is not negotiated; both ends of the link have to set
+    the same compression. Received data that is not a valid block sets the
+    \l ReadError error. Since the start of the next block cannot be found,
+    all data received after it is dropped until the compression is set
+    again, the input is cleared with clear(), or the serial port is
+    reopened. Changing the compression writes the data of a block that is
+    not full yet and discards a partially received block.
+
+    \sa compression(), compressionStatistics()
+*/
+void QSerialPort::setCompression(Compression compression)
 {
     Q_D(QSerialPort);
+    if (d->compression == compression)
+        return;
+    d->flushCompression();
+    d->decompressPending.clear();
+    d->decompressFailed = false;
+    d->compression = compression;
+}
 
-    if (isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::OpenError));
-        return false;
-    }
-
-    // Define while not supported modes.
-    static const OpenMode unsupportedModes = Append | Truncate | Text | Unbuffered;
-    if ((mode & unsupportedModes) || mode == NotOpen) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError, tr("Unsupported open mode")));
-        return false;
-    }
+/*!
+    \since 6.9
 
-    clearError();
-    if (!d->open(mode))
-        return false;
+    Returns the compression of the data of the serial port.
 
-    QIODevice::open(mode);
-    return true;
+    \sa setCompression()
+*/
+QSerialPort::Compression QSerialPort::compression() const
+{
+    Q_D(const QSerialPort);
+    return d->compression;
 }
 
 /*!
-    \reimp
+    \since 6.9
 
-    \note The serial port has to be open before trying to close it; otherwise
-    sets the NotOpenError error code.
+    Sets the time that written data waits for a compression block to fill
+    up to \a msecs milliseconds. Larger timeouts let short writes share a
+    block and compress better, at the cost of latency. With a timeout of 0,
+    every write() ends with a block of its own.
 
-    \sa QIODevice::close()
+    The default timeout is 5 milliseconds.
+
+    \sa compressionFlushTimeout(), setCompression()
 */
-void QSerialPort::close()
+void QSerialPort::setCompressionFlushTimeout(int msecs)
 {
     Q_D(QSerialPort);
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        return;
-    }
+    d->compressionFlushTimeout = qMax(msecs, 0);
+}
 
-    d->close();
-    d->isBreakEnabled.setValue(false);
-    QIODevice::close();
+/*!
+    \since 6.9
+
+    Returns the time that written data waits for a compression block to
+    fill up, in milliseconds.
+
+    \sa setCompressionFlushTimeout()
+*/
+int QSerialPort::compressionFlushTimeout() const
+{
+    Q_D(const QSerialPort);
+    return d->compressionFlushTimeout;
 }
 
 /*!
-    \property QSerialPort::baudRate
-    \brief the data baud rate for the desired direction
+    \since 6.9
 
-    If the setting is successful or set before opening the port, returns \c true;
-    otherwise returns \c false and sets an error code which can be obtained by
-    accessing the value of the QSerialPort::error property. To set the baud
-    rate, use the enumeration QSerialPort::BaudRate or any positive qint32
-    value.
+    Returns the amount of data compressed and decompressed since the
+    serial port was created or resetCompressionStatistics() was called.
 
-    \note If the setting is set before opening the port, the actual serial port
-    setting is done automatically in the \l{QSerialPort::open()} method right
-    after that the opening of the port succeeds.
+    \sa setCompression(), QSerialPortCompressionStatistics
+*/
+QSerialPortCompressionStatistics QSerialPort::compressionStatistics() const
+{
+    Q_D(const QSerialPort);
+    return d->compressionStats;
+}
 
-    \warning Setting the AllDirections flag is supported on all platforms.
-    Windows supports only this mode.
+/*!
+    \since 6.9
 
-    \warning Returns equal baud rate in any direction on Windows.
+    Clears the amount of data compressed and decompressed so far.
 
-    The default value is Baud9600, i.e. 9600 bits per second.
+    \sa compressionStatistics()
 */
-bool QSerialPort::setBaudRate(qint32 baudRate, Directions directions)
+void QSerialPort::resetCompressionStatistics()
 {
     Q_D(QSerialPort);
+    d->compressionStats = QSerialPortCompressionStatistics();
+}
 
-    if (!isOpen() || d->setBaudRate(baudRate, directions)) {
-        if (directions & QSerialPort::Input) {
-            if (d->inputBaudRate != baudRate)
-                d->inputBaudRate = baudRate;
-            else
-                directions &= ~QSerialPort::Input;
-        }
+/*!
+    \enum QSerialPort::LineErrorType
+    \since 6.9
 
-        if (directions & QSerialPort::Output) {
-            if (d->outputBaudRate != baudRate)
-                d->outputBaudRate = baudRate;
-            else
-                directions &= ~QSerialPort::Output;
-        }
+    This enum describes the line errors reported by takeLineErrors().
 
-        if (directions)
-            emit baudRateChanged(baudRate, directions);
+    \value BreakCondition A break condition was received. A character of
+            all zero bits received with a parity or framing error is
+            reported as a break too, as the driver marks both the same way.
+    \value CharacterError A character was received with a parity or a
+            framing error. The character stays in the data.
+*/
 
-        return true;
-    }
+/*!
+    \class QSerialPort::LineError
+    \inmodule QtSerialPort
+    \since 6.9
 
-    return false;
-}
+    \brief Describes a line error received by a serial port.
 
-qint32 QSerialPort::baudRate(Directions directions) const
-{
-    Q_D(const QSerialPort);
-    if (directions == QSerialPort::AllDirections)
-        return d->inputBaudRate == d->outputBaudRate ?
-                    d->inputBaudRate : -1;
-    return directions & QSerialPort::Input ? d->inputBaudRate : d->outputBaudRate;
-}
+    \sa QSerialPort::takeLineErrors()
+*/
 
 /*!
-    \fn void QSerialPort::baudRateChanged(qint32 baudRate, Directions directions)
+    \variable QSerialPort::LineError::type
 
-    This signal is emitted after the baud rate has been changed. The new baud
-    rate is passed as \a baudRate and directions as \a directions.
+    The type of the line error.
+*/
 
-    \sa QSerialPort::baudRate
+/*!
+    \variable QSerialPort::LineError::position
+
+    The position of the line error in the received data, counting the
+    bytes received since the serial port was opened. For a
+    \l{QSerialPort::}{CharacterError}, it is the position of the
+    character; for a \l{QSerialPort::}{BreakCondition}, the position of
+    the byte received after the break.
 */
 
 /*!
-    \property QSerialPort::dataBits
-    \brief the data bits in a frame
+    \since 6.9
 
-    If the setting is successful or set before opening the port, returns
-    \c true; otherwise returns \c false and sets an error code which can be obtained
-    by accessing the value of the QSerialPort::error property.
+    If \a enable is \c true, characters received with a parity or framing
+    error and break conditions are reported through takeLineErrors()
+    instead of being dropped silently. Protocols that mark the start of a
+    frame with a break, such as DMX512, need this.
 
-    \note If the setting is set before opening the port, the actual serial port
-    setting is done automatically in the \l{QSerialPort::open()} method right
-    after that the opening of the port succeeds.
+    The driver is set up to mark the errors in the data (\c PARMRK, and
+    \c INPCK with parity), and the marks are removed from the received
+    data as it is read, with a scan for the 0xFF escape byte. The data
+    itself is unchanged: a character received with an error stays in it,
+    and a break takes no room. lineErrorsReceived() is emitted once the
+    data around the errors is in the read buffer.
 
-    The default value is Data8, i.e. 8 data bits.
+    Returns \c true on success. If the serial port is open, the setting is
+    applied right away; otherwise it takes effect when it is opened.
+
+    \note Line error reporting is only supported on Unix systems.
+
+    \sa isLineErrorReportingEnabled(), takeLineErrors()
 */
-bool QSerialPort::setDataBits(DataBits dataBits)
+bool QSerialPort::setLineErrorReportingEnabled(bool enable)
 {
     Q_D(QSerialPort);
-    d->dataBits.removeBindingUnlessInWrapper();
-    const auto currentDataBits = d->dataBits.valueBypassingBindings();
-    if (!isOpen() || d->setDataBits(dataBits)) {
-        d->dataBits.setValueBypassingBindings(dataBits);
-        if (currentDataBits != dataBits) {
-            d->dataBits.notify();
-            emit dataBitsChanged(dataBits);
-        }
-        return true;
-    }
-    return false;
+    if (isOpen() && !d->backend->setLineErrorReporting(enable))
+        return false;
+    d->lineErrorReporting = enable;
+    return true;
 }
 
-QSerialPort::DataBits QSerialPort::dataBits() const
+/*!
+    \since 6.9
+
+    Returns \c true if line errors are reported.
+
+    \sa setLineErrorReportingEnabled()
+*/
+bool QSerialPort::isLineErrorReportingEnabled() const
 {
     Q_D(const QSerialPort);
-    return d->dataBits;
+    return d->lineErrorReporting;
 }
 
-QBindable<QSerialPort::DataBits> QSerialPort::bindableDataBits()
+/*!
+    \since 6.9
+
+    Returns the line errors received since the last call, in the order in
+    which they were received, and forgets them.
+
+    \sa setLineErrorReportingEnabled(), lineErrorsReceived()
+*/
+QList<QSerialPort::LineError> QSerialPort::takeLineErrors()
 {
-    return &d_func()->dataBits;
+    Q_D(QSerialPort);
+    return std::exchange(d->lineErrors, {});
 }
 
 /*!
-    \fn void QSerialPort::dataBitsChanged(DataBits dataBits)
+    \since 6.9
+
+    If \a enable is \c true, the serial port uses the parity bit as a 9th
+    data bit, as the address bit of multidrop buses such as MDB. The data
+    bits are set to 8 and the parity to space at rest, with sticky parity
+    (\c CMSPAR).
+
+    Use writeNineBit() to send data with the 9th bit set or cleared, and
+    readNineBit() to read data along with its 9th bit. A received byte
+    with the 9th bit set fails the parity check and is marked by the
+    driver, as with setLineErrorReportingEnabled(); it is recorded as a
+    \l{QSerialPort::}{CharacterError} that readNineBit() turns back into
+    the 9th bit. A byte received with a framing error cannot be told apart
+    from it, and a break reads as a 0x00 with the 9th bit set. Data read
+    with read() leaves its 9th bits to takeLineErrors().
+
+    The bytes written with write() go out with the 9th bit cleared. The
+    9-bit mode cannot be combined with compression, filters, a data handler
+    or a framing, which change the received data that the 9th bits refer
+    to; readNineBit() fails while any of them is set.
+
+    Returns \c true on success. If the serial port is open, the setting is
+    applied right away; otherwise it takes effect when it is opened.
+    Returns \c false and sets UnsupportedOperationError if compression,
+    filters, a data handler or a framing is set.
+
+    \note The 9-bit mode is only supported on Linux.
+
+    \sa isNineBitModeEnabled()
+*/
+bool QSerialPort::setNineBitModeEnabled(bool enable)
+{
+    Q_D(QSerialPort);
+    if (enable && d->isReadDataProcessed()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                         tr("9-bit mode cannot be combined with compression, "
+                                            "filters, a data handler or a framing")));
+        return false;
+    }
+    if (isOpen() && !d->backend->setNineBitMode(enable))
+        return false;
+    d->nineBitMode = enable;
+    return true;
+}
 
-    This signal is emitted after the data bits in a frame has been changed. The
-    new data bits in a frame is passed as \a dataBits.
+/*!
+    \since 6.9
 
-    \sa QSerialPort::dataBits
-*/
+    Returns \c true if the 9-bit mode is enabled.
 
+    \sa setNineBitModeEnabled()
+*/
+bool QSerialPort::isNineBitModeEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->nineBitMode;
+}
 
 /*!
-    \property QSerialPort::parity
-    \brief the parity checking mode
+    \since 6.9
 
-    If the setting is successful or set before opening the port, returns \c true;
-    otherwise returns \c false and sets an error code which can be obtained by
-    accessing the value of the QSerialPort::error property.
+    Sends \a data with the 9th bit of every byte set to \a ninthBit, and
+    returns the number of bytes written, or -1 if an error occurred.
 
-    \note If the setting is set before opening the port, the actual serial port
-    setting is done automatically in the \l{QSerialPort::open()} method right
-    after that the opening of the port succeeds.
+    The data is written with a single write to the driver, without going
+    through the write buffer. Data still in the write buffer is sent
+    first. This function blocks until the driver has taken all the data,
+    with no time limit; setWriteBufferTimeout() does not apply. Data with
+    the 9th bit set is sent with mark parity, which is switched back to
+    space once the driver has sent it; for that data, this function blocks
+    until then.
 
-    The default value is NoParity, i.e. no parity.
+    \sa setNineBitModeEnabled(), readNineBit()
 */
-bool QSerialPort::setParity(Parity parity)
+qint64 QSerialPort::writeNineBit(QByteArrayView data, bool ninthBit)
 {
     Q_D(QSerialPort);
-    d->parity.removeBindingUnlessInWrapper();
-    const auto currentParity = d->parity.valueBypassingBindings();
-    if (!isOpen() || d->setParity(parity)) {
-        d->parity.setValueBypassingBindings(parity);
-        if (currentParity != parity) {
-            d->parity.notify();
-            emit parityChanged(parity);
-        }
-        return true;
+
+    if (!d->nineBitMode) {
+        qWarning("QSerialPort::writeNineBit: 9-bit mode not enabled");
+        return -1;
     }
-    return false;
+    if (!isWritable()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        return -1;
+    }
+    if (data.isEmpty())
+        return 0;
+    return d->backend->writeNineBit(data, ninthBit);
 }
 
-QSerialPort::Parity QSerialPort::parity() const
-{
-    Q_D(const QSerialPort);
-    return d->parity;
-}
+/*!
+    \since 6.9
+    \overload
 
-QBindable<QSerialPort::Parity> QSerialPort::bindableParity()
+    Sends the 9-bit \a words, taking the 9th bit from bit 8 of each word.
+    The words with the same 9th bit in a row are sent with a single write.
+    Returns the number of words written, or -1 if an error occurred.
+*/
+qint64 QSerialPort::writeNineBit(const QList<quint16> &words)
 {
-    return &d_func()->parity;
+    QByteArray run;
+    qint64 written = 0;
+    for (qsizetype i = 0; i < words.size();) {
+        const bool ninthBit = words.at(i) & 0x100;
+        run.clear();
+        for (; i < words.size() && bool(words.at(i) & 0x100) == ninthBit; ++i)
+            run.append(char(words.at(i)));
+        if (writeNineBit(run, ninthBit) != run.size())
+            return written > 0 ? written : qint64(-1);
+        written += run.size();
+    }
+    return written;
 }
 
 /*!
-    \fn void QSerialPort::parityChanged(Parity parity)
+    \since 6.9
 
-    This signal is emitted after the parity checking mode has been changed. The
-    new parity checking mode is passed as \a parity.
+    Reads at most \a maxCount bytes, with the 9th bit of each in bit 8 of
+    the word returned for it. The line errors of the data read are
+    consumed, and no longer returned by takeLineErrors().
 
-    \sa QSerialPort::parity
+    Returns an empty list and sets UnsupportedOperationError if
+    compression, filters, a data handler or a framing is set, since the
+    positions of the line errors then do not match the data read.
+
+    \sa setNineBitModeEnabled(), writeNineBit()
 */
+QList<quint16> QSerialPort::readNineBit(qint64 maxCount)
+{
+    Q_D(QSerialPort);
+
+    if (d->isReadDataProcessed()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                         tr("9-bit mode cannot be combined with compression, "
+                                            "filters, a data handler or a framing")));
+        return {};
+    }
+
+    // Position of the first byte read, counted as in LineError::position
+    const qint64 position = d->lineStreamPosition - d->buffer.size();
+    const QByteArray data = read(maxCount);
+
+    QList<quint16> words;
+    words.reserve(data.size());
+    for (char c : data)
+        words.append(quint8(c));
+
+    const qint64 end = position + data.size();
+    qsizetype consumed = 0;
+    for (const LineError &error : std::as_const(d->lineErrors)) {
+        if (error.position >= end)
+            break;
+        if (error.type == CharacterError && error.position >= position)
+            words[error.position - position] |= 0x100;
+        ++consumed;
+    }
+    d->lineErrors.remove(0, consumed);
+    return words;
+}
 
 /*!
-    \property QSerialPort::stopBits
-    \brief the number of stop bits in a frame
+    \since 6.9
 
-    If the setting is successful or set before opening the port, returns \c true;
-    otherwise returns \c false and sets an error code which can be obtained by
-    accessing the value of the QSerialPort::error property.
+    If \a enable is \c true, the serial port is opened in blocking mode,
+    for threads that do not run an event loop. No notifications are used
+    and nothing is read from the driver in the background:
 
-    \note If the setting is set before opening the port, the actual serial port
-    setting is done automatically in the \l{QSerialPort::open()} method right
-    after that the opening of the port succeeds.
+    \list
+    \li read() is a single blocking read from the driver straight into
+         the buffer of the caller. It returns once the requested number of
+         bytes arrived, or with the bytes received so far once the line has
+         been quiet for the inter-byte timeout set with
+         setInterByteTimeout(). Without that timeout, it returns as soon as
+         any data is available. It blocks until then, with no upper limit.
+    \li After a read() that returned data, the next one only takes data
+         that is pending in the driver already, and returns 0 if there is
+         none; the read after that blocks again. This way readAll() and
+         loops that read until nothing is left return once the data
+         pending has been read.
+    \li bytesAvailable() includes the data pending in the driver.
+    \li write() blocks until all the data has been handed over to the
+         driver and emits bytesWritten() before it returns.
+    \endlist
 
-    The default value is OneStop, i.e. 1 stop bit.
+    The driver assembles the data of a read, so a request/response
+    exchange takes one system call per direction and no copy through the
+    read buffer, which is why the serial port is opened with
+    QIODevice::Unbuffered. Functions that read line by line, like
+    readLine(), read one byte at a time and should be avoided. With
+    compression, filters, a data handler or a framing set, every read takes
+    up to 32 KiB from the driver and passes them on as usual.
+    waitForReadyRead() keeps working, filling the read buffer that read()
+    drains first.
+
+    The blocking mode takes precedence over the I/O thread. The setting
+    takes effect the next time the serial port is opened.
+
+    \note The blocking mode is only supported on Unix systems.
+
+    \sa isBlockingModeEnabled(), setInterByteTimeout()
 */
-bool QSerialPort::setStopBits(StopBits stopBits)
+void QSerialPort::setBlockingModeEnabled(bool enable)
 {
     Q_D(QSerialPort);
-    d->stopBits.removeBindingUnlessInWrapper();
-    const auto currentStopBits = d->stopBits.valueBypassingBindings();
-    if (!isOpen() || d->setStopBits(stopBits)) {
-        d->stopBits.setValueBypassingBindings(stopBits);
-        if (currentStopBits != stopBits) {
-            d->stopBits.notify();
-            emit stopBitsChanged(stopBits);
-        }
-        return true;
-    }
-    return false;
+    d->blockingModeEnabled = enable;
+}
+
+/*!
+    \since 6.9
+
+    Returns \c true if the serial port is opened in blocking mode.
+
+    \sa setBlockingModeEnabled()
+*/
+bool QSerialPort::isBlockingModeEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->blockingModeEnabled;
 }
 
-QSerialPort::StopBits QSerialPort::stopBits() const
+/*!
+    \since 6.9
+
+    Sets the inter-byte timeout of reads in blocking mode to \a msecs
+    milliseconds. A read that received some data returns once no further
+    byte arrived within the timeout, even if fewer bytes than requested
+    were received. The driver counts the timeout in tenths of a second, up
+    to 25.5 seconds, and returns after at most 255 bytes when the timeout
+    is set; \a msecs is rounded up accordingly. A timeout of 0, the
+    default, lets a read return as soon as any data is available.
+
+    The setting takes effect the next time the serial port is opened.
+
+    \sa interByteTimeout(), setBlockingModeEnabled()
+*/
+void QSerialPort::setInterByteTimeout(int msecs)
 {
-    Q_D(const QSerialPort);
-    return d->stopBits;
+    Q_D(QSerialPort);
+    d->interByteTimeout = qMax(msecs, 0);
 }
 
-QBindable<QSerialPort::StopBits> QSerialPort::bindableStopBits(QT6_IMPL_NEW_OVERLOAD)
+/*!
+    \since 6.9
+
+    Returns the inter-byte timeout of reads in blocking mode, in
+    milliseconds.
+
+    \sa setInterByteTimeout()
+*/
+int QSerialPort::interByteTimeout() const
 {
-    return &d_func()->stopBits;
+    Q_D(const QSerialPort);
+    return d->interByteTimeout;
 }
 
 /*!
-    \fn void QSerialPort::stopBitsChanged(StopBits stopBits)
+    \enum QSerialPort::SchedulingPolicy
+    \since 6.9
 
-    This signal is emitted after the number of stop bits in a frame has been
-    changed. The new number of stop bits in a frame is passed as \a stopBits.
+    This enum describes the scheduling policy of the I/O thread.
 
-    \sa QSerialPort::stopBits
+    \value DefaultScheduling The thread is scheduled like any other thread.
+    \value FifoScheduling The thread runs under the real-time \c SCHED_FIFO
+            policy.
+    \value RoundRobinScheduling The thread runs under the real-time
+            \c SCHED_RR policy.
+
+    \sa setIoThreadScheduling()
 */
 
 /*!
-    \property QSerialPort::flowControl
-    \brief the desired flow control mode
+    \since 6.9
 
-    If the setting is successful or set before opening the port, returns \c true;
-    otherwise returns \c false and sets an error code which can be obtained by
-    accessing the value of the QSerialPort::error property.
+    If \a enable is \c true, the data received by the serial port is read
+    from the driver on a dedicated thread instead of the thread the serial
+    port belongs to. The data is still delivered to the read buffer, and
+    readyRead() is still emitted, in the thread of the serial port.
 
-    \note If the setting is set before opening the port, the actual serial port
-    setting is done automatically in the \l{QSerialPort::open()} method right
-    after that the opening of the port succeeds.
+    The dedicated thread wakes up as soon as data arrives, no matter how
+    busy the event loop of the thread of the serial port is, so the time
+    between the arrival of the data and the read from the driver is short
+    and predictable. Use setIoThreadScheduling() and
+    setIoThreadCpuAffinity() to run it under a real-time policy on a
+    chosen CPU, and latencyStatistics() to measure the result.
 
-    The default value is NoFlowControl, i.e. no flow control.
+    The setting takes effect the next time the serial port is opened.
+
+    \note The I/O thread is only supported on Unix systems.
+
+    \sa isIoThreadEnabled()
 */
-bool QSerialPort::setFlowControl(FlowControl flowControl)
+void QSerialPort::setIoThreadEnabled(bool enable)
 {
     Q_D(QSerialPort);
-    d->flowControl.removeBindingUnlessInWrapper();
-    const auto currentFlowControl = d->flowControl.valueBypassingBindings();
-    if (!isOpen() || d->setFlowControl(flowControl)) {
-        d->flowControl.setValueBypassingBindings(flowControl);
-        if (currentFlowControl != flowControl) {
-            d->flowControl.notify();
-            emit flowControlChanged(flowControl);
-        }
-        return true;
-    }
-    return false;
+    d->ioThreadEnabled = enable;
 }
 
-QSerialPort::FlowControl QSerialPort::flowControl() const
+/*!
+    \since 6.9
+
+    Returns \c true if the serial port reads from the driver on a dedicated
+    thread.
+
+    \sa setIoThreadEnabled()
+*/
+bool QSerialPort::isIoThreadEnabled() const
 {
     Q_D(const QSerialPort);
-    return d->flowControl;
+    return d->ioThreadEnabled;
 }
 
-QBindable<QSerialPort::FlowControl> QSerialPort::bindableFlowControl()
+/*!
+    \since 6.9
+
+    Sets the scheduling \a policy and the \a priority of the I/O thread.
+    The priority is only used by the real-time policies, where it must be
+    in the range that \c sched_get_priority_min() and
+    \c sched_get_priority_max() report for the policy.
+
+    The real-time policies usually require privileges, such as the
+    \c CAP_SYS_NICE capability on Linux. If the policy can not be applied
+    when the serial port is opened, open() fails, with
+    \l PermissionError if the privileges are missing.
+
+    The setting takes effect the next time the serial port is opened.
+
+    \sa setIoThreadEnabled(), ioThreadSchedulingPolicy(), ioThreadPriority()
+*/
+void QSerialPort::setIoThreadScheduling(SchedulingPolicy policy, int priority)
 {
-    return &d_func()->flowControl;
+    Q_D(QSerialPort);
+    d->ioThreadSchedulingPolicy = policy;
+    d->ioThreadPriority = priority;
 }
 
 /*!
-    \fn void QSerialPort::flowControlChanged(FlowControl flow)
+    \since 6.9
 
-    This signal is emitted after the flow control mode has been changed. The
-    new flow control mode is passed as \a flow.
+    Returns the scheduling policy of the I/O thread.
 
-    \sa QSerialPort::flowControl
+    \sa setIoThreadScheduling()
 */
+QSerialPort::SchedulingPolicy QSerialPort::ioThreadSchedulingPolicy() const
+{
+    Q_D(const QSerialPort);
+    return d->ioThreadSchedulingPolicy;
+}
 
 /*!
-    \property QSerialPort::dataTerminalReady
-    \brief the state (high or low) of the line signal DTR
-
-    Returns \c true on success, \c false otherwise.
-    If the flag is \c true then the DTR signal is set to high; otherwise low.
+    \since 6.9
 
-    \note The serial port has to be open before trying to set or get this
-    property; otherwise \c false is returned and the error code is set to
-    NotOpenError.
+    Returns the real-time priority of the I/O thread.
 
-    \sa pinoutSignals()
+    \sa setIoThreadScheduling()
 */
-bool QSerialPort::setDataTerminalReady(bool set)
+int QSerialPort::ioThreadPriority() const
 {
-    Q_D(QSerialPort);
+    Q_D(const QSerialPort);
+    return d->ioThreadPriority;
+}
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+/*!
+    \since 6.9
 
-    const bool dataTerminalReady = isDataTerminalReady();
-    const bool retval = d->setDataTerminalReady(set);
-    if (retval && (dataTerminalReady != set))
-        emit dataTerminalReadyChanged(set);
+    Restricts the I/O thread to the CPUs with the indexes in \a cpus. An
+    empty list lets the thread run on any CPU.
 
-    return retval;
-}
+    CPU affinity is only supported on Linux; elsewhere, open() fails with
+    \l UnsupportedOperationError if \a cpus is not empty.
 
-bool QSerialPort::isDataTerminalReady()
+    The setting takes effect the next time the serial port is opened.
+
+    \sa setIoThreadEnabled(), ioThreadCpuAffinity()
+*/
+void QSerialPort::setIoThreadCpuAffinity(const QList<int> &cpus)
 {
     Q_D(QSerialPort);
-    return d->pinoutSignals() & QSerialPort::DataTerminalReadySignal;
+    d->ioThreadCpus = cpus;
 }
 
 /*!
-    \fn void QSerialPort::dataTerminalReadyChanged(bool set)
+    \since 6.9
 
-    This signal is emitted after the state (high or low) of the line signal DTR
-    has been changed. The new the state (high or low) of the line signal DTR is
-    passed as \a set.
+    Returns the CPUs the I/O thread is restricted to.
 
-    \sa QSerialPort::dataTerminalReady
+    \sa setIoThreadCpuAffinity()
 */
+QList<int> QSerialPort::ioThreadCpuAffinity() const
+{
+    Q_D(const QSerialPort);
+    return d->ioThreadCpus;
+}
 
 /*!
-    \property QSerialPort::requestToSend
-    \brief the state (high or low) of the line signal RTS
+    \since 6.9
 
-    Returns \c true on success, \c false otherwise.
-    If the flag is \c true then the RTS signal is set to high; otherwise low.
+    Returns the latencies measured by the I/O thread since the serial port
+    was opened or resetLatencyStatistics() was called.
 
-    \note The serial port has to be open before trying to set or get this
-    property; otherwise \c false is returned and the error code is set to
-    NotOpenError.
+    The wakeup-to-read latency is the time from the I/O thread waking up
+    because data arrived to the data being read from the driver. The
+    read-to-deliver latency is the time from the read to the data being
+    appended to the read buffer in the thread of the serial port, right
+    before readyRead() is emitted.
 
-    \note An attempt to control the RTS signal in the HardwareControl mode
-    will fail with error code set to UnsupportedOperationError, because
-    the signal is automatically controlled by the driver.
+    Without the I/O thread, no latencies are measured.
 
-    \sa pinoutSignals()
+    \sa setIoThreadEnabled(), QSerialPortLatencyStatistics
 */
-bool QSerialPort::setRequestToSend(bool set)
+QSerialPortLatencyStatistics QSerialPort::latencyStatistics() const
 {
-    Q_D(QSerialPort);
-
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+    Q_D(const QSerialPort);
+    QMutexLocker locker(&d->latencyMutex);
+    return d->latency;
+}
 
-    if (d->flowControl == QSerialPort::HardwareControl) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError));
-        return false;
-    }
+/*!
+    \since 6.9
 
-    const bool requestToSend = isRequestToSend();
-    const bool retval = d->setRequestToSend(set);
-    if (retval && (requestToSend != set))
-        emit requestToSendChanged(set);
+    Clears the latencies measured so far.
 
-    return retval;
+    \sa latencyStatistics()
+*/
+void QSerialPort::resetLatencyStatistics()
+{
+    Q_D(QSerialPort);
+    QMutexLocker locker(&d->latencyMutex);
+    d->latency = QSerialPortLatencyStatistics();
 }
 
-bool QSerialPort::isRequestToSend()
+/*!
+    \since 6.9
+
+    Sets the \a highWatermark and the \a lowWatermark of the internal read
+    buffer, in bytes.
+
+    When the amount of buffered data reaches the high watermark, the
+    readBufferNearlyFull() signal is emitted, and the sender is throttled as
+    configured with setReadBufferThrottling(). The sender is released again
+    once the application has read enough data for the buffer to drop to the
+    low watermark. The read buffer is checked when a read needs more data
+    than it holds or empties it, as readAll() and readChunk() do; a read()
+    served from the buffer alone leaves the check to the next one. This
+    protects a slow consumer against losing data at high baud rates, long
+    before the read buffer size limit is hit.
+
+    If \a lowWatermark is negative or not below \a highWatermark, half of
+    \a highWatermark is used. A \a highWatermark of \c 0 (the default)
+    disables the watermarks.
+
+    \sa readBufferHighWatermark(), readBufferLowWatermark(), setReadBufferSize()
+*/
+void QSerialPort::setReadBufferWatermarks(qint64 highWatermark, qint64 lowWatermark)
 {
     Q_D(QSerialPort);
-    return d->pinoutSignals() & QSerialPort::RequestToSendSignal;
+    d->readBufferHighWatermark = qMax(highWatermark, qint64(0));
+    d->readBufferLowWatermark = (lowWatermark >= 0 && lowWatermark < d->readBufferHighWatermark)
+            ? lowWatermark : d->readBufferHighWatermark / 2;
+    if (isOpen())
+        d->checkReadBufferWatermarks();
 }
 
 /*!
-    \fn void QSerialPort::requestToSendChanged(bool set)
+    \since 6.9
 
-    This signal is emitted after the state (high or low) of the line signal RTS
-    has been changed. The new the state (high or low) of the line signal RTS is
-    passed as \a set.
+    Returns the high watermark of the internal read buffer.
 
-    \sa QSerialPort::requestToSend
+    \sa setReadBufferWatermarks()
 */
+qint64 QSerialPort::readBufferHighWatermark() const
+{
+    Q_D(const QSerialPort);
+    return d->readBufferHighWatermark;
+}
 
 /*!
-    Returns the state of the line signals in a bitmap format.
-
-    From this result, it is possible to allocate the state of the
-    desired signal by applying a mask "AND", where the mask is
-    the desired enumeration value from QSerialPort::PinoutSignals.
-
-    \note This method performs a system call, thus ensuring that the line signal
-    states are returned properly. This is necessary when the underlying
-    operating systems cannot provide proper notifications about the changes.
+    \since 6.9
 
-    \note The serial port has to be open before trying to get the pinout
-    signals; otherwise returns NoSignal and sets the NotOpenError error code.
+    Returns the low watermark of the internal read buffer.
 
-    \sa QSerialPort::dataTerminalReady, QSerialPort::requestToSend
+    \sa setReadBufferWatermarks()
 */
-QSerialPort::PinoutSignals QSerialPort::pinoutSignals()
+qint64 QSerialPort::readBufferLowWatermark() const
 {
-    Q_D(QSerialPort);
+    Q_D(const QSerialPort);
+    return d->readBufferLowWatermark;
+}
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return QSerialPort::NoSignal;
-    }
+/*!
+    \since 6.9
+
+    Returns how the sender is throttled when the read buffer reaches its
+    high watermark.
 
-    return d->pinoutSignals();
+    \sa setReadBufferThrottling(), setReadBufferWatermarks()
+*/
+QSerialPort::FlowControl QSerialPort::readBufferThrottling() const
+{
+    Q_D(const QSerialPort);
+    return d->readBufferThrottling;
 }
 
 /*!
-    This function writes as much as possible from the internal write
-    buffer to the underlying serial port without blocking. If any data
-    was written, this function returns \c true; otherwise returns \c false.
+    \since 6.9
 
-    Call this function for sending the buffered data immediately to the serial
-    port. The number of bytes successfully written depends on the operating
-    system. In most cases, this function does not need to be called, because the
-    QSerialPort class will start sending data automatically once control is
-    returned to the event loop. In the absence of an event loop, call
-    waitForBytesWritten() instead.
+    Sets how the sender is throttled when the read buffer reaches its high
+    watermark to \a throttling:
 
-    \note The serial port has to be open before trying to flush any buffered
-    data; otherwise returns \c false and sets the NotOpenError error code.
+    \list
+    \li NoFlowControl: only the readBufferNearlyFull() signal is emitted.
+        This is the default.
+    \li HardwareControl: the RTS line is deasserted, and asserted again
+        when the buffer drops to the low watermark. If the port itself uses
+        hardware flow control, the RTS line is left to the driver.
+    \li SoftwareControl: an XOFF character is sent, and an XON character
+        when the buffer drops to the low watermark.
+    \endlist
 
-    \sa write(), waitForBytesWritten()
+    \sa readBufferThrottling(), setReadBufferWatermarks()
 */
-bool QSerialPort::flush()
+void QSerialPort::setReadBufferThrottling(FlowControl throttling)
 {
     Q_D(QSerialPort);
+    if (d->readThrottled && isOpen())
+        d->backend->throttleRead(false);
+    d->readBufferThrottling = throttling;
+    if (d->readThrottled && isOpen())
+        d->backend->throttleRead(true);
+}
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+/*!
+    \since 6.9
+
+    Returns the maximum size of the internal write buffer.
 
-    return d->flush();
+    A write buffer size of \c 0 (the default) means that the buffer has
+    no size limit.
+
+    \sa setWriteBufferMaxSize(), writeBufferPolicy(), bytesToWrite()
+*/
+qint64 QSerialPort::writeBufferMaxSize() const
+{
+    Q_D(const QSerialPort);
+    return d->writeBufferMaxSize;
 }
 
 /*!
-    Discards all characters from the output or input buffer, depending on
-    given directions \a directions. This includes clearing the internal class buffers and
-    the UART (driver) buffers. Also terminate pending read or write operations.
-    If successful, returns \c true; otherwise returns \c false.
+    \since 6.9
 
-    \note The serial port has to be open before trying to clear any buffered
-    data; otherwise returns \c false and sets the NotOpenError error code.
+    Limits the size of QSerialPort's internal write buffer to \a size bytes.
+
+    If the buffer size is limited, write() does not buffer more than this
+    amount of data. What happens with the data that does not fit depends on
+    the writeBufferPolicy(). The writeBufferFull() signal is emitted when the
+    buffer becomes full, and the writeBufferDrained() signal is emitted once
+    the amount of buffered data drops to half of \a size again. This allows a
+    producer to throttle itself instead of polling bytesToWrite().
+
+    The special case of a buffer size of \c 0 means that the write buffer is
+    unlimited. This is the default.
+
+    \sa writeBufferMaxSize(), setWriteBufferPolicy(), setReadBufferSize()
 */
-bool QSerialPort::clear(Directions directions)
+void QSerialPort::setWriteBufferMaxSize(qint64 size)
 {
     Q_D(QSerialPort);
-
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
+    d->writeBufferMaxSize = qMax(size, qint64(0));
+    if (d->writeBufferMaxSize == 0 && d->writeBufferFullEmitted) {
+        d->writeBufferFullEmitted = false;
+        emit writeBufferDrained();
+    } else {
+        d->checkWriteBufferDrained();
     }
-
-    if (directions & Input)
-        d->buffer.clear();
-    if (directions & Output)
-        d->writeBuffer.clear();
-    return d->clear(directions);
 }
 
 /*!
-    \property QSerialPort::error
-    \brief the error status of the serial port
+    \since 6.9
 
-    The I/O device status returns an error code. For example, if open()
-    returns \c false, or a read/write operation returns \c -1, this property can
-    be used to figure out the reason why the operation failed.
+    Returns the policy applied by write() when the write buffer is full.
 
-    The error code is set to the default QSerialPort::NoError after a call to
-    clearError()
+    \sa setWriteBufferPolicy(), writeBufferMaxSize()
 */
-QSerialPort::SerialPortError QSerialPort::error() const
+QSerialPort::WriteBufferPolicy QSerialPort::writeBufferPolicy() const
 {
     Q_D(const QSerialPort);
-    return d->error;
+    return d->writeBufferPolicy;
 }
 
-void QSerialPort::clearError()
+/*!
+    \since 6.9
+
+    Sets the \a policy applied by write() when the data does not fit into
+    the write buffer. The default is RejectWhenFull.
+
+    The policy has no effect as long as the write buffer is unlimited.
+
+    \sa writeBufferPolicy(), setWriteBufferMaxSize(), setWriteBufferTimeout()
+*/
+void QSerialPort::setWriteBufferPolicy(WriteBufferPolicy policy)
 {
     Q_D(QSerialPort);
-    d->setError(QSerialPortErrorInfo(QSerialPort::NoError));
+    d->writeBufferPolicy = policy;
 }
 
-QBindable<QSerialPort::SerialPortError> QSerialPort::bindableError() const
+/*!
+    \since 6.9
+
+    Returns the maximum time in milliseconds that write() blocks when the
+    BlockWhenFull policy is used.
+
+    \sa setWriteBufferTimeout(), setWriteBufferPolicy()
+*/
+int QSerialPort::writeBufferTimeout() const
 {
-    return &d_func()->error;
+    Q_D(const QSerialPort);
+    return d->writeBufferTimeout;
 }
 
 /*!
-    \fn void QSerialPort::errorOccurred(SerialPortError error)
-    \since 5.8
+    \since 6.9
 
-    This signal is emitted when an error occurs in the serial port.
-    The specified \a error describes the type of error that occurred.
+    Sets the maximum time in milliseconds that write() blocks waiting for
+    room in the write buffer to \a msecs, when the BlockWhenFull policy is
+    used. If \a msecs is -1, write() waits until all of the data is
+    accepted. The default is 30000 milliseconds.
 
-    \sa QSerialPort::error
+    \note While waiting, write() processes the port like
+    waitForBytesWritten() does, so the bytesWritten() and readyRead() signals
+    can be emitted from inside write().
+
+    \sa writeBufferTimeout(), setWriteBufferPolicy()
 */
+void QSerialPort::setWriteBufferTimeout(int msecs)
+{
+    Q_D(QSerialPort);
+    d->writeBufferTimeout = msecs;
+}
 
 /*!
-    Returns the size of the internal read buffer. This limits the
-    amount of data that the client can receive before calling the read()
-    or readAll() methods.
+    \since 6.9
 
-    A read buffer size of \c 0 (the default) means that the buffer has
-    no size limit, ensuring that no data is lost.
+    Enables the immediate write mode if \a enable is \c true; otherwise
+    disables it. The mode is disabled by default.
 
-    \sa setReadBufferSize(), read()
+    Normally, write() only appends the data to the internal write buffer, and
+    the data is passed to the driver once control returns to the event loop.
+    In the immediate write mode, write() tries to pass the data to the driver
+    right away, without blocking, if nothing is queued in the write buffer and
+    no write operation is in progress. Only the part which the driver did not
+    accept is buffered. This saves an event loop round trip for each short
+    command.
+
+    The \l{QIODevice::}{bytesWritten()} signal is still emitted from the event
+    loop (or from waitForBytesWritten()), and never from inside write().
+
+    \sa isImmediateWriteEnabled(), write(), flush()
 */
-qint64 QSerialPort::readBufferSize() const
+void QSerialPort::setImmediateWriteEnabled(bool enable)
 {
-    Q_D(const QSerialPort);
-    return d->readBufferMaxSize;
+    Q_D(QSerialPort);
+    d->immediateWrite = enable;
 }
 
 /*!
-    Sets the size of QSerialPort's internal read buffer to be \a
-    size bytes.
-
-    If the buffer size is limited to a certain size, QSerialPort
-    will not buffer more than this size of data. The special case of a buffer
-    size of \c 0 means that the read buffer is unlimited and all
-    incoming data is buffered. This is the default.
+    \since 6.9
 
-    This option is useful if the data is only read at certain points
-    in time (for instance in a real-time streaming application) or if the serial
-    port should be protected against receiving too much data, which may
-    eventually cause the application to run out of memory.
+    Returns \c true if the immediate write mode is enabled; otherwise
+    returns \c false.
 
-    \sa readBufferSize(), read()
+    \sa setImmediateWriteEnabled()
 */
-void QSerialPort::setReadBufferSize(qint64 size)
+bool QSerialPort::isImmediateWriteEnabled() const
 {
-    Q_D(QSerialPort);
-    d->readBufferMaxSize = size;
-    if (isReadable())
-        d->startAsyncRead();
+    Q_D(const QSerialPort);
+    return d->immediateWrite;
 }
 
 /*!
@@ -1040,6 +3263,14 @@ bool QSerialPort::isSequential() const
 */
 qint64 QSerialPort::bytesAvailable() const
 {
+#if defined(Q_OS_UNIX)
+    // Nothing is read in the background, count what the driver holds
+    Q_D(const QSerialPort);
+    if (d->blockingModeActive) {
+        const qint64 queued = const_cast<QSerialPortPrivate *>(d)->driverQueueSizes().input;
+        return QIODevice::bytesAvailable() + qMax(queued, qint64(0));
+    }
+#endif
     return QIODevice::bytesAvailable();
 }
 
@@ -1054,7 +3285,7 @@ qint64 QSerialPort::bytesAvailable() const
 */
 qint64 QSerialPort::bytesToWrite() const
 {
-    qint64 pendingBytes = QIODevice::bytesToWrite();
+    qint64 pendingBytes = QIODevice::bytesToWrite() + d_func()->compressPending.size();
 #if defined(Q_OS_WIN32)
     pendingBytes += d_func()->writeChunkBuffer.size();
 #endif
@@ -1074,6 +3305,43 @@ bool QSerialPort::canReadLine() const
     return QIODevice::canReadLine();
 }
 
+/*!
+    \since 6.9
+
+    Reads the next contiguous block of data from the read buffer and
+    returns it. Large reads from the port are kept in the read buffer as
+    separate blocks, and are returned by this function without copying.
+    Returns an empty byte array if no data is available.
+
+    The serial port keeps a reference to such a block, to reuse its memory
+    for another read once it is released. The returned array is therefore
+    shared: reading it costs no copy, but modifying it, for example with
+    data(), detaches it and copies the data first. Use constData() to keep
+    it copy-free.
+
+    Unlike readAll(), this function may return less data than
+    bytesAvailable(); call it until it returns an empty byte array to
+    drain the read buffer. If a transaction is in progress, this function
+    behaves like readAll().
+
+    \sa readAll(), bytesAvailable()
+*/
+QByteArray QSerialPort::readChunk()
+{
+    Q_D(QSerialPort);
+
+    if (!isReadable() || isTransactionStarted())
+        return readAll();
+
+    QByteArray chunk = d->buffer.read();
+
+    // Same as in readData(), the buffer may have room for more data now
+    d->checkReadBufferWatermarks();
+    d->backend->resumeRead();
+
+    return chunk;
+}
+
 /*!
     \reimp
 
@@ -1091,7 +3359,7 @@ bool QSerialPort::canReadLine() const
 bool QSerialPort::waitForReadyRead(int msecs)
 {
     Q_D(QSerialPort);
-    return d->waitForReadyRead(msecs);
+    return d->backend->waitForDataRead(msecs);
 }
 
 /*!
@@ -1120,7 +3388,71 @@ bool QSerialPort::waitForReadyRead(int msecs)
 bool QSerialPort::waitForBytesWritten(int msecs)
 {
     Q_D(QSerialPort);
-    return d->waitForBytesWritten(msecs);
+    if (isOpen() && !d->flushCompression())
+        return false;
+    return d->backend->waitForDataWritten(msecs);
+}
+
+/*!
+    \since 6.9
+
+    Blocks until all the data written to the serial port has left the UART
+    or \a deadline expires, and emits transmitComplete(). Data still in
+    the write buffer is handed over to the driver first.
+
+    Unlike waitForBytesWritten(), which returns as soon as the driver
+    accepted the data, this function waits for the data to be on the
+    wire. Half-duplex links, such as RS-485, can turn the line around
+    right after it returns. The function polls the output queue of the
+    driver, sleeping for the time the queued characters take at the
+    current baud rate in between. Where the driver reports the line
+    status of the UART, it waits for the transmitter to be empty;
+    otherwise it allows one more character time once the output queue
+    is empty.
+
+    Returns \c true once the data has been sent; otherwise returns
+    \c false, and sets the TimeoutError error code if \a deadline
+    expired.
+
+    \note Not supported with a QSerialPortBackend selected by the port name.
+
+    \sa transmitComplete(), waitForBytesWritten()
+*/
+bool QSerialPort::waitForTransmitComplete(QDeadlineTimer deadline)
+{
+    Q_D(QSerialPort);
+
+    if (!isWritable()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        return false;
+    }
+
+    if (!d->flushCompression())
+        return false;
+    while (bytesToWrite() > 0) {
+        if (!waitForBytesWritten(int(deadline.remainingTime())))
+            return false;
+    }
+
+    for (;;) {
+        qint64 remaining = d->transmitTimeRemaining();
+        if (remaining < 0)
+            return false;
+        if (remaining == 0)
+            break;
+        if (deadline.hasExpired()) {
+            d->setError(QSerialPortErrorInfo(QSerialPort::TimeoutError));
+            return false;
+        }
+        if (!deadline.isForever())
+            remaining = qMin(remaining, deadline.remainingTimeNSecs());
+        QThread::sleep(std::chrono::nanoseconds(remaining));
+    }
+
+    if (d->transmitCheckTimer)
+        d->transmitCheckTimer->stop();
+    emit transmitComplete();
+    return true;
 }
 
 /*!
@@ -1145,7 +3477,7 @@ bool QSerialPort::setBreakEnabled(bool set)
     d->isBreakEnabled.removeBindingUnlessInWrapper();
     const auto currentSet = d->isBreakEnabled.valueBypassingBindings();
     if (isOpen()) {
-        if (d->setBreakEnabled(set)) {
+        if (d->backend->setBreakEnabled(set)) {
             d->isBreakEnabled.setValueBypassingBindings(set);
             if (currentSet != set) {
                 d->isBreakEnabled.notify();
@@ -1171,26 +3503,148 @@ QBindable<bool> QSerialPort::bindableIsBreakEnabled()
     return &d_func()->isBreakEnabled;
 }
 
+/*!
+    \property QSerialPort::rs485Configuration
+    \since 6.9
+    \brief the RS-485 mode of the driver
+
+    With the RS-485 mode enabled, the driver switches the direction of the
+    transceiver with the RTS line around every transmission, with the
+    delays set in the configuration. This is both faster and more precise
+    than calling setRequestToSend() before and after every write, and the
+    RTS line should not be changed by other means meanwhile.
+
+    The setter returns \c true on success. If the serial port is open, the
+    configuration is applied right away; otherwise it is applied when the
+    serial port is opened, and opening fails if it cannot be. When the
+    serial port is closed, the previous RS-485 settings of the driver are
+    restored along with the other settings, see settingsRestoredOnClose.
+    A disabled configuration, the default, leaves the settings of the
+    driver unchanged when opening.
+
+    If the driver does not support the RS-485 mode, the setter sets the
+    UnsupportedOperationError error code. The driver may limit the delays.
+
+    \note The RS-485 mode is only supported on Linux, with \c TIOCSRS485.
+*/
+bool QSerialPort::setRs485Configuration(const QSerialPortRs485Configuration &configuration)
+{
+    Q_D(QSerialPort);
+    d->rs485Configuration.removeBindingUnlessInWrapper();
+    const auto currentConfiguration = d->rs485Configuration.valueBypassingBindings();
+    if (!isOpen() || d->backend->setRs485Configuration(configuration)) {
+        d->rs485Configuration.setValueBypassingBindings(configuration);
+        if (currentConfiguration != configuration) {
+            d->rs485Configuration.notify();
+            emit rs485ConfigurationChanged(configuration);
+        }
+        return true;
+    }
+    return false;
+}
+
+QSerialPortRs485Configuration QSerialPort::rs485Configuration() const
+{
+    Q_D(const QSerialPort);
+    return d->rs485Configuration;
+}
+
+QBindable<QSerialPortRs485Configuration> QSerialPort::bindableRs485Configuration()
+{
+    return &d_func()->rs485Configuration;
+}
+
+/*!
+    \fn void QSerialPort::rs485ConfigurationChanged(const QSerialPortRs485Configuration &configuration)
+    \since 6.9
+
+    This signal is emitted after the RS-485 configuration has been changed
+    to \a configuration.
+
+    \sa rs485Configuration
+*/
+
+/*!
+    \fn void QSerialPort::readBufferNearlyFull()
+    \since 6.9
+
+    This signal is emitted when the amount of data in the read buffer
+    reaches the high watermark. It is not emitted again until the buffer has
+    dropped to the low watermark.
+
+    \sa setReadBufferWatermarks(), setReadBufferThrottling()
+*/
+
+/*!
+    \fn void QSerialPort::writeBufferFull()
+    \since 6.9
+
+    This signal is emitted when the limited write buffer becomes full, or
+    when data is dropped because of the DropOldestWhenFull policy. It is not
+    emitted again until writeBufferDrained() has been emitted.
+
+    \sa setWriteBufferMaxSize(), writeBufferDrained()
+*/
+
+/*!
+    \fn void QSerialPort::writeBufferDrained()
+    \since 6.9
+
+    This signal is emitted after writeBufferFull() once the amount of
+    buffered data drops to half of writeBufferMaxSize() or below.
+
+    \sa setWriteBufferMaxSize(), writeBufferFull()
+*/
+
+/*!
+    \fn void QSerialPort::frameReceived(const QByteArray &frame)
+    \since 6.9
+
+    This signal is emitted for every complete \a frame decoded with the
+    framing set by setFraming().
+
+    \sa setFraming(), writeFrame()
+*/
+
+/*!
+    \fn void QSerialPort::lineErrorsReceived()
+    \since 6.9
+
+    This signal is emitted when line errors were received, once the data
+    up to them is in the read buffer. Call takeLineErrors() to get them.
+
+    \sa setLineErrorReportingEnabled()
+*/
+
+/*!
+    \fn void QSerialPort::transmitComplete()
+    \since 6.9
+
+    This signal is emitted when the data written to the serial port has
+    left the UART, as opposed to bytesWritten(), which is emitted when the
+    driver accepted it. It is emitted once the write buffer drained and
+    the output queue of the driver and the transmitter are empty, as
+    estimated from the current baud rate and checked with a timer, and
+    by waitForTransmitComplete().
+
+    The output queue is only watched while the signal is connected.
+
+    \sa waitForTransmitComplete()
+*/
+
 /*!
     \reimp
 
     \omit
     This function does not really read anything, as we use QIODevicePrivate's
     buffer. The buffer will be read inside of QIODevice before this
-    method will be called.
+    method will be called. In blocking mode, it reads from the driver
+    straight into \a data.
     \endomit
 */
 qint64 QSerialPort::readData(char *data, qint64 maxSize)
 {
-    Q_UNUSED(data);
-    Q_UNUSED(maxSize);
-
-    // In any case we need to start the notifications if they were
-    // disabled by the read handler. If enabled, next call does nothing.
-    d_func()->startAsyncRead();
-
-    // return 0 indicating there may be more data in the future
-    return qint64(0);
+    return d_func()->backend->readData(data, maxSize);
 }
 
 /*!
@@ -1207,9 +3661,246 @@ qint64 QSerialPort::readLineData(char *data, qint64 maxSize)
 qint64 QSerialPort::writeData(const char *data, qint64 maxSize)
 {
     Q_D(QSerialPort);
-    return d->writeData(data, maxSize);
+    // The output of the filters cannot be mapped back to the data taken,
+    // so a filtered write is taken whole or not at all
+    if (!d->filters.isEmpty())
+        return d->writeWhole(data, maxSize);
+    return d->writeUnfiltered(data, maxSize);
 }
 
+/*!
+    \class QSerialPortLatencyStatistics
+    \since 6.9
+
+    \brief Holds the latencies measured by the I/O thread of a serial port.
+
+    \ingroup serialport-main
+    \inmodule QtSerialPort
+
+    \sa QSerialPort::latencyStatistics(), QSerialPort::setIoThreadEnabled()
+*/
+
+/*!
+    \fn QSerialPortLatencyStatistics::QSerialPortLatencyStatistics()
+
+    Constructs an object with no latencies recorded.
+*/
+
+/*!
+    \fn qint64 QSerialPortLatencyStatistics::readCount() const
+
+    Returns the number of reads from the driver that were measured.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::minimumWakeupToRead() const
+
+    Returns the shortest time from a wakeup of the I/O thread to the read
+    from the driver.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::maximumWakeupToRead() const
+
+    Returns the longest time from a wakeup of the I/O thread to the read
+    from the driver.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::averageWakeupToRead() const
+
+    Returns the average time from a wakeup of the I/O thread to the read
+    from the driver.
+*/
+
+/*!
+    \fn qint64 QSerialPortLatencyStatistics::deliveryCount() const
+
+    Returns the number of deliveries to the read buffer that were measured.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::minimumReadToDeliver() const
+
+    Returns the shortest time from a read from the driver to the delivery
+    of the data in the thread of the serial port.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::maximumReadToDeliver() const
+
+    Returns the longest time from a read from the driver to the delivery
+    of the data in the thread of the serial port.
+*/
+
+/*!
+    \fn std::chrono::nanoseconds QSerialPortLatencyStatistics::averageReadToDeliver() const
+
+    Returns the average time from a read from the driver to the delivery
+    of the data in the thread of the serial port.
+*/
+
+/*!
+    \class QSerialPortCompressionStatistics
+    \since 6.9
+
+    \brief Holds the amount of data compressed and decompressed by a serial port.
+
+    The compressed sizes include the headers of the blocks, so the ratios
+    describe the effect on the wire.
+
+    \ingroup serialport-main
+    \inmodule QtSerialPort
+
+    \sa QSerialPort::compressionStatistics(), QSerialPort::setCompression()
+*/
+
+/*!
+    \fn QSerialPortCompressionStatistics::QSerialPortCompressionStatistics()
+
+    Constructs an object with no data recorded.
+*/
+
+/*!
+    \fn qint64 QSerialPortCompressionStatistics::uncompressedBytesWritten() const
+
+    Returns the number of bytes that were compressed for writing.
+*/
+
+/*!
+    \fn qint64 QSerialPortCompressionStatistics::compressedBytesWritten() const
+
+    Returns the number of bytes that the written data was compressed to.
+*/
+
+/*!
+    \fn double QSerialPortCompressionStatistics::writeRatio() const
+
+    Returns uncompressedBytesWritten() divided by compressedBytesWritten(),
+    or 1 if nothing was written. A ratio of 3 means that the data took a
+    third of its size on the wire.
+*/
+
+/*!
+    \fn qint64 QSerialPortCompressionStatistics::compressedBytesRead() const
+
+    Returns the number of bytes of the received blocks that were
+    decompressed.
+*/
+
+/*!
+    \fn qint64 QSerialPortCompressionStatistics::uncompressedBytesRead() const
+
+    Returns the number of bytes that the received data was decompressed to.
+*/
+
+/*!
+    \fn double QSerialPortCompressionStatistics::readRatio() const
+
+    Returns uncompressedBytesRead() divided by compressedBytesRead(), or 1
+    if nothing was received.
+*/
+
+/*!
+    \class QSerialPortRs485Configuration
+    \since 6.9
+
+    \brief Describes the RS-485 mode of a serial port driver.
+
+    The driver drives the RTS line to switch an RS-485 transceiver
+    between transmitting and receiving. By default, the mode is disabled,
+    RTS is set while sending and cleared after it, without delays.
+
+    \ingroup serialport-main
+    \inmodule QtSerialPort
+
+    \sa QSerialPort::rs485Configuration
+*/
+
+/*!
+    \fn QSerialPortRs485Configuration::QSerialPortRs485Configuration()
+
+    Constructs a disabled configuration with the default settings.
+*/
+
+/*!
+    \fn bool QSerialPortRs485Configuration::isEnabled() const
+
+    Returns \c true if the RS-485 mode is enabled.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setEnabled(bool enable)
+
+    Enables the RS-485 mode if \a enable is \c true.
+*/
+
+/*!
+    \fn bool QSerialPortRs485Configuration::isRequestToSendOnSend() const
+
+    Returns \c true if RTS is set while sending.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setRequestToSendOnSend(bool set)
+
+    Sets the level of RTS while sending to \a set. This is \c true by
+    default.
+*/
+
+/*!
+    \fn bool QSerialPortRs485Configuration::isRequestToSendAfterSend() const
+
+    Returns \c true if RTS is set after sending.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setRequestToSendAfterSend(bool set)
+
+    Sets the level of RTS after sending, while receiving, to \a set. This
+    is \c false by default.
+*/
+
+/*!
+    \fn std::chrono::milliseconds QSerialPortRs485Configuration::delayBeforeSend() const
+
+    Returns the delay between switching RTS and sending.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setDelayBeforeSend(std::chrono::milliseconds delay)
+
+    Sets the delay between switching RTS and sending to \a delay.
+*/
+
+/*!
+    \fn std::chrono::milliseconds QSerialPortRs485Configuration::delayAfterSend() const
+
+    Returns the delay between the end of the transmission and switching
+    RTS back.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setDelayAfterSend(std::chrono::milliseconds delay)
+
+    Sets the delay between the end of the transmission and switching RTS
+    back to \a delay.
+*/
+
+/*!
+    \fn bool QSerialPortRs485Configuration::isReceiveDuringTransmitEnabled() const
+
+    Returns \c true if data is received while sending.
+*/
+
+/*!
+    \fn void QSerialPortRs485Configuration::setReceiveDuringTransmitEnabled(bool enable)
+
+    If \a enable is \c true, data is received while sending, as with a
+    transceiver that echoes the transmitted data. This is \c false by
+    default.
+*/
+
 QT_END_NAMESPACE
 
 #include "moc_qserialport.cpp"
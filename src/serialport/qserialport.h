@@ -5,16 +5,125 @@
 #ifndef QSERIALPORT_H
 #define QSERIALPORT_H
 
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qiodevice.h>
 #include <QtCore/qproperty.h>
 
 #include <QtSerialPort/qserialportglobal.h>
 
+#include <chrono>
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+class QSerialPortFilter;
 class QSerialPortInfo;
 class QSerialPortPrivate;
 
+class Q_SERIALPORT_EXPORT QSerialPortLatencyStatistics
+{
+public:
+    constexpr QSerialPortLatencyStatistics() noexcept = default;
+
+    qint64 readCount() const noexcept { return reads; }
+    std::chrono::nanoseconds minimumWakeupToRead() const noexcept
+    { return std::chrono::nanoseconds(wakeupToReadMinimum); }
+    std::chrono::nanoseconds maximumWakeupToRead() const noexcept
+    { return std::chrono::nanoseconds(wakeupToReadMaximum); }
+    std::chrono::nanoseconds averageWakeupToRead() const noexcept
+    { return std::chrono::nanoseconds(reads ? wakeupToReadTotal / reads : 0); }
+
+    qint64 deliveryCount() const noexcept { return deliveries; }
+    std::chrono::nanoseconds minimumReadToDeliver() const noexcept
+    { return std::chrono::nanoseconds(readToDeliverMinimum); }
+    std::chrono::nanoseconds maximumReadToDeliver() const noexcept
+    { return std::chrono::nanoseconds(readToDeliverMaximum); }
+    std::chrono::nanoseconds averageReadToDeliver() const noexcept
+    { return std::chrono::nanoseconds(deliveries ? readToDeliverTotal / deliveries : 0); }
+
+private:
+    friend class QSerialPortPrivate;
+
+    qint64 reads = 0;
+    qint64 wakeupToReadMinimum = 0;
+    qint64 wakeupToReadMaximum = 0;
+    qint64 wakeupToReadTotal = 0;
+    qint64 deliveries = 0;
+    qint64 readToDeliverMinimum = 0;
+    qint64 readToDeliverMaximum = 0;
+    qint64 readToDeliverTotal = 0;
+};
+
+class Q_SERIALPORT_EXPORT QSerialPortCompressionStatistics
+{
+public:
+    constexpr QSerialPortCompressionStatistics() noexcept = default;
+
+    qint64 uncompressedBytesWritten() const noexcept { return plainWritten; }
+    qint64 compressedBytesWritten() const noexcept { return packedWritten; }
+    double writeRatio() const noexcept
+    { return packedWritten ? double(plainWritten) / double(packedWritten) : 1.0; }
+
+    qint64 compressedBytesRead() const noexcept { return packedRead; }
+    qint64 uncompressedBytesRead() const noexcept { return plainRead; }
+    double readRatio() const noexcept
+    { return packedRead ? double(plainRead) / double(packedRead) : 1.0; }
+
+private:
+    friend class QSerialPortPrivate;
+
+    qint64 plainWritten = 0;
+    qint64 packedWritten = 0;
+    qint64 packedRead = 0;
+    qint64 plainRead = 0;
+};
+
+class Q_SERIALPORT_EXPORT QSerialPortRs485Configuration
+{
+public:
+    constexpr QSerialPortRs485Configuration() noexcept = default;
+
+    constexpr bool isEnabled() const noexcept { return enabled; }
+    constexpr void setEnabled(bool enable) noexcept { enabled = enable; }
+
+    constexpr bool isRequestToSendOnSend() const noexcept { return rtsOnSend; }
+    constexpr void setRequestToSendOnSend(bool set) noexcept { rtsOnSend = set; }
+
+    constexpr bool isRequestToSendAfterSend() const noexcept { return rtsAfterSend; }
+    constexpr void setRequestToSendAfterSend(bool set) noexcept { rtsAfterSend = set; }
+
+    constexpr std::chrono::milliseconds delayBeforeSend() const noexcept { return beforeSend; }
+    constexpr void setDelayBeforeSend(std::chrono::milliseconds delay) noexcept
+    { beforeSend = delay; }
+
+    constexpr std::chrono::milliseconds delayAfterSend() const noexcept { return afterSend; }
+    constexpr void setDelayAfterSend(std::chrono::milliseconds delay) noexcept
+    { afterSend = delay; }
+
+    constexpr bool isReceiveDuringTransmitEnabled() const noexcept { return rxDuringTx; }
+    constexpr void setReceiveDuringTransmitEnabled(bool enable) noexcept { rxDuringTx = enable; }
+
+private:
+    friend constexpr bool operator==(const QSerialPortRs485Configuration &lhs,
+                                     const QSerialPortRs485Configuration &rhs) noexcept
+    {
+        return lhs.enabled == rhs.enabled && lhs.rtsOnSend == rhs.rtsOnSend
+                && lhs.rtsAfterSend == rhs.rtsAfterSend && lhs.rxDuringTx == rhs.rxDuringTx
+                && lhs.beforeSend == rhs.beforeSend && lhs.afterSend == rhs.afterSend;
+    }
+    friend constexpr bool operator!=(const QSerialPortRs485Configuration &lhs,
+                                     const QSerialPortRs485Configuration &rhs) noexcept
+    { return !(lhs == rhs); }
+
+    bool enabled = false;
+    bool rtsOnSend = true;
+    bool rtsAfterSend = false;
+    bool rxDuringTx = false;
+    std::chrono::milliseconds beforeSend = std::chrono::milliseconds::zero();
+    std::chrono::milliseconds afterSend = std::chrono::milliseconds::zero();
+};
+
 class Q_SERIALPORT_EXPORT QSerialPort : public QIODevice
 {
     Q_OBJECT
@@ -34,6 +143,9 @@ class Q_SERIALPORT_EXPORT QSerialPort : public QIODevice
     Q_PROPERTY(SerialPortError error READ error RESET clearError NOTIFY errorOccurred BINDABLE bindableError)
     Q_PROPERTY(bool breakEnabled READ isBreakEnabled WRITE setBreakEnabled NOTIFY breakEnabledChanged
                 BINDABLE bindableIsBreakEnabled)
+    Q_PROPERTY(QSerialPortRs485Configuration rs485Configuration READ rs485Configuration
+                WRITE setRs485Configuration NOTIFY rs485ConfigurationChanged
+                BINDABLE bindableRs485Configuration)
 
 #if defined(Q_OS_WIN32)
     typedef void* Handle;
@@ -123,6 +235,58 @@ public:
     };
     Q_ENUM(SerialPortError)
 
+    enum WriteBufferPolicy {
+        RejectWhenFull,
+        BlockWhenFull,
+        DropOldestWhenFull
+    };
+    Q_ENUM(WriteBufferPolicy)
+
+    enum Framing {
+        NoFraming,
+        SlipFraming,
+        CobsFraming,
+        HdlcFraming
+    };
+    Q_ENUM(Framing)
+
+    enum FrameCheck {
+        NoFrameCheck,
+        Crc16ModbusCheck,
+        Crc16CcittCheck,
+        Crc32Check
+    };
+    Q_ENUM(FrameCheck)
+
+    enum Compression {
+        NoCompression,
+        Lz4Compression
+    };
+    Q_ENUM(Compression)
+
+    enum LineErrorType {
+        BreakCondition,
+        CharacterError
+    };
+    Q_ENUM(LineErrorType)
+
+    enum SchedulingPolicy {
+        DefaultScheduling,
+        FifoScheduling,
+        RoundRobinScheduling
+    };
+    Q_ENUM(SchedulingPolicy)
+
+    struct DriverQueueSizes {
+        qint64 input = -1;
+        qint64 output = -1;
+    };
+
+    struct LineError {
+        LineErrorType type = CharacterError;
+        qint64 position = 0;
+    };
+
     explicit QSerialPort(QObject *parent = nullptr);
     explicit QSerialPort(const QString &name, QObject *parent = nullptr);
     explicit QSerialPort(const QSerialPortInfo &info, QObject *parent = nullptr);
@@ -134,6 +298,7 @@ public:
     void setPort(const QSerialPortInfo &info);
 
     bool open(OpenMode mode) override;
+    static bool openAll(const QList<QSerialPort *> &serialPorts, OpenMode mode);
     void close() override;
 
     bool setBaudRate(qint32 baudRate, Directions directions = AllDirections);
@@ -165,6 +330,7 @@ public:
     bool isRequestToSend();
 
     PinoutSignals pinoutSignals();
+    DriverQueueSizes driverQueueSizes();
 
     bool flush();
     bool clear(Directions directions = AllDirections);
@@ -176,19 +342,102 @@ public:
     qint64 readBufferSize() const;
     void setReadBufferSize(qint64 size);
 
+    void setReadBufferWatermarks(qint64 highWatermark, qint64 lowWatermark);
+    qint64 readBufferHighWatermark() const;
+    qint64 readBufferLowWatermark() const;
+
+    FlowControl readBufferThrottling() const;
+    void setReadBufferThrottling(FlowControl throttling);
+
+    qint64 writeBufferMaxSize() const;
+    void setWriteBufferMaxSize(qint64 size);
+
+    WriteBufferPolicy writeBufferPolicy() const;
+    void setWriteBufferPolicy(WriteBufferPolicy policy);
+
+    int writeBufferTimeout() const;
+    void setWriteBufferTimeout(int msecs);
+
+    void setImmediateWriteEnabled(bool enable);
+    bool isImmediateWriteEnabled() const;
+
+    void setCaptureDevice(QIODevice *device);
+    QIODevice *captureDevice() const;
+
+    using DataHandler = std::function<void(QByteArrayView data)>;
+    void setDataHandler(DataHandler handler);
+
+    void setFraming(Framing framing);
+    Framing framing() const;
+    qint64 writeFrame(QByteArrayView frame);
+
+    void addFilter(QSerialPortFilter *filter);
+    void removeFilter(QSerialPortFilter *filter);
+    QList<QSerialPortFilter *> filters() const;
+
+    void setFrameCheck(FrameCheck check);
+    FrameCheck frameCheck() const;
+    qint64 frameCheckErrorCount() const;
+    void resetFrameCheckErrorCount();
+
+    void setCompression(Compression compression);
+    Compression compression() const;
+
+    void setCompressionFlushTimeout(int msecs);
+    int compressionFlushTimeout() const;
+
+    QSerialPortCompressionStatistics compressionStatistics() const;
+    void resetCompressionStatistics();
+
+    bool setLineErrorReportingEnabled(bool enable);
+    bool isLineErrorReportingEnabled() const;
+    QList<LineError> takeLineErrors();
+
+    bool setNineBitModeEnabled(bool enable);
+    bool isNineBitModeEnabled() const;
+    qint64 writeNineBit(QByteArrayView data, bool ninthBit);
+    qint64 writeNineBit(const QList<quint16> &words);
+    QList<quint16> readNineBit(qint64 maxCount);
+
+    void setBlockingModeEnabled(bool enable);
+    bool isBlockingModeEnabled() const;
+
+    void setInterByteTimeout(int msecs);
+    int interByteTimeout() const;
+
+    void setIoThreadEnabled(bool enable);
+    bool isIoThreadEnabled() const;
+
+    void setIoThreadScheduling(SchedulingPolicy policy, int priority = 0);
+    SchedulingPolicy ioThreadSchedulingPolicy() const;
+    int ioThreadPriority() const;
+
+    void setIoThreadCpuAffinity(const QList<int> &cpus);
+    QList<int> ioThreadCpuAffinity() const;
+
+    QSerialPortLatencyStatistics latencyStatistics() const;
+    void resetLatencyStatistics();
+
     bool isSequential() const override;
 
     qint64 bytesAvailable() const override;
     qint64 bytesToWrite() const override;
     bool canReadLine() const override;
 
+    QByteArray readChunk();
+
     bool waitForReadyRead(int msecs = 30000) override;
     bool waitForBytesWritten(int msecs = 30000) override;
+    bool waitForTransmitComplete(QDeadlineTimer deadline = QDeadlineTimer(30000));
 
     bool setBreakEnabled(bool set = true);
     bool isBreakEnabled() const;
     QBindable<bool> bindableIsBreakEnabled();
 
+    bool setRs485Configuration(const QSerialPortRs485Configuration &configuration);
+    QSerialPortRs485Configuration rs485Configuration() const;
+    QBindable<QSerialPortRs485Configuration> bindableRs485Configuration();
+
     Handle handle() const;
 
 Q_SIGNALS:
@@ -201,6 +450,13 @@ Q_SIGNALS:
     void requestToSendChanged(bool set);
     void errorOccurred(QSerialPort::SerialPortError error);
     void breakEnabledChanged(bool set);
+    void readBufferNearlyFull();
+    void writeBufferFull();
+    void writeBufferDrained();
+    void frameReceived(const QByteArray &frame);
+    void transmitComplete();
+    void lineErrorsReceived();
+    void rs485ConfigurationChanged(const QSerialPortRs485Configuration &configuration);
 
 protected:
     qint64 readData(char *data, qint64 maxSize) override;
@@ -18,13 +18,22 @@
 //
 
 #include "qserialport.h"
+#include "qserialportbackend_p.h"
+#include "qserialportfilter.h"
+#include "qserialportframing_p.h"
 
 #include <qdeadlinetimer.h>
+#include <qelapsedtimer.h>
+#include <qmutex.h>
+#include <qpointer.h>
+#include <qwaitcondition.h>
 
 #include <private/qiodevice_p.h>
 #include <private/qproperty_p.h>
+#include <private/qringbuffer_p.h>
 
 #include <memory>
+#include <optional>
 
 #if defined(Q_OS_WIN32)
 #  include <qt_windows.h>
@@ -69,11 +78,27 @@ struct serial_struct {
 #define QSERIALPORT_BUFFERSIZE 32768
 #endif
 
+#ifndef QSERIALPORT_READCHUNKPOOLSIZE
+#define QSERIALPORT_READCHUNKPOOLSIZE 8
+#endif
+
+// Data the I/O thread reads ahead of the read buffer, in bytes
+#ifndef QSERIALPORT_IOSTAGINGSIZE
+#define QSERIALPORT_IOSTAGINGSIZE (16 * QSERIALPORT_BUFFERSIZE)
+#endif
+
+// How often waitForReadyRead() checks for pending writes while waiting
+// for the I/O thread, in milliseconds
+#ifndef QSERIALPORT_IOWRITEPOLLINTERVAL
+#define QSERIALPORT_IOWRITEPOLLINTERVAL 10
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QWinOverlappedIoNotifier;
 class QTimer;
 class QSocketNotifier;
+class QThread;
 
 #if defined(Q_OS_UNIX)
 QString serialPortLockFilePath(const QString &portName);
@@ -95,7 +120,11 @@ public:
 
     QSerialPortPrivate();
 
+    bool prepareOpen(QIODevice::OpenMode mode);
     bool open(QIODevice::OpenMode mode);
+    bool openDevice(QIODevice::OpenMode mode);
+    bool startNotifications(QIODevice::OpenMode mode);
+    void completeOpen(QIODevice::OpenMode mode);
     void close();
 
     QSerialPort::PinoutSignals pinoutSignals();
@@ -124,12 +153,162 @@ public:
     void setError(const QSerialPortErrorInfo &errorInfo);
 
     qint64 writeData(const char *data, qint64 maxSize);
+    qint64 writeDataBounded(const char *data, qint64 maxSize);
+    bool waitForWriteRoom(qint64 size);
+    qint64 writeRecord(const char *data, qint64 size);
+    void emitWriteBufferFull();
+    void checkWriteBufferDrained();
+    void checkReadBufferWatermarks();
+    bool throttleRead(bool throttle);
+
+    QByteArray takeReadChunk();
+    qint64 appendReadChunk(QByteArray &&chunk, qint64 size);
+    char *reserveRead(qint64 maxSize);
+    qint64 commitRead(char *data, qint64 maxSize, qint64 size);
+
+    void captureRecord(quint8 type, const char *data, qint64 size);
+    void captureSettings();
+
+    void scheduleBackendRead();
+    void scheduleBackendWrite();
 
     bool initialize(QIODevice::OpenMode mode);
 
     static QList<qint32> standardBaudRates();
 
     qint64 readBufferMaxSize = 0;
+    bool immediateWrite = false;
+
+    // Receive chunks of QSERIALPORT_BUFFERSIZE bytes, kept across open/close.
+    // Chunks handed over to the read buffer stay here and are recycled once
+    // the consumer has released them.
+    QList<QByteArray> readChunkPool;
+    // See reserveRead(): the size of the previous read predicts whether the
+    // next one goes into a pooled chunk or straight into the read buffer
+    qint64 previousReadSize = 0;
+    bool readIntoChunk = false;
+    QByteArray currentReadChunk;
+
+    QPointer<QIODevice> captureDevice;
+    QElapsedTimer captureTimer;
+
+    // Receive the data instead of the read buffer, see QSerialPort::setDataHandler()
+    // and QSerialPort::setFraming()
+    QSerialPort::DataHandler dataHandler;
+    QSerialPortFrameCodec frameCodec;
+
+    bool isReadBufferBypassed() const
+    { return dataHandler || frameCodec.framing() != QSerialPort::NoFraming; }
+    void consumeReadData(QByteArrayView data);
+
+    // See QSerialPort::addFilter()
+    QList<QSerialPortFilter *> filters;
+    qint64 filteredReadBytes = 0;
+    bool filteredWriteFailed = false;
+
+    qint64 receiveReadData(QByteArrayView data);
+    void filterInbound(qsizetype stage, QByteArrayView data);
+    void filterOutbound(qsizetype stage, QByteArrayView data);
+    qint64 writeWhole(const char *data, qint64 maxSize);
+    qint64 writeFiltered(const char *data, qint64 maxSize);
+    qint64 writeUnfiltered(const char *data, qint64 maxSize);
+    qint64 writeRaw(const char *data, qint64 maxSize);
+    bool startWriteBuffer();
+
+    // See QSerialPort::setCompression()
+    QSerialPort::Compression compression = QSerialPort::NoCompression;
+    int compressionFlushTimeout = 5;
+    QTimer *compressionFlushTimer = nullptr;
+    QByteArray compressPending;
+    QByteArray compressBlock;
+    QByteArray decompressPending;
+    // The block boundaries were lost to corrupted data, see decompressInbound()
+    bool decompressFailed = false;
+    QByteArray decompressBlock;
+    QSerialPortCompressionStatistics compressionStats;
+    // A block was refused by a bounded write buffer, retried once it drained
+    bool compressionFlushDeferred = false;
+
+    qint64 compressOutbound(const char *data, qint64 maxSize);
+    void scheduleCompressionFlush();
+    void startCompressionFlushTimer(int msecs);
+    qint64 writeCompressedBlock(QByteArrayView block);
+    bool flushCompression();
+    void decompressInbound(QByteArrayView data);
+
+    // Received data does not go straight into the read buffer
+    bool isReadDataProcessed() const
+    {
+        return isReadBufferBypassed() || !filters.isEmpty()
+                || compression != QSerialPort::NoCompression;
+    }
+
+    void recordWakeupToRead(qint64 nsecs);
+    void recordReadToDeliver(qint64 nsecs);
+
+    // See QSerialPort::transmitComplete()
+    QTimer *transmitCheckTimer = nullptr;
+    QDeadlineTimer transmitDrainDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
+
+    qint64 characterTime() const;
+    qint64 transmitTimeRemaining();
+    qint64 transmitQueueSize(std::optional<bool> *transmitterEmpty);
+    QSerialPort::DriverQueueSizes driverQueueSizes();
+    void scheduleTransmitCheck();
+
+    bool blockingModeEnabled = false;
+    int interByteTimeout = 0;
+
+    // See QSerialPort::setLineErrorReportingEnabled(). The position counts
+    // the received bytes left after removing the marks.
+    bool lineErrorReporting = false;
+    int lineMarkState = 0;
+    qint64 lineStreamPosition = 0;
+    QList<QSerialPort::LineError> lineErrors;
+    bool lineErrorsPending = false;
+
+    bool setLineErrorReporting(bool enable);
+
+    // See QSerialPort::setNineBitModeEnabled(); the 9th bits of the
+    // received data are recorded as line errors
+    bool nineBitMode = false;
+
+    bool setNineBitMode(bool enable);
+    qint64 writeNineBit(QByteArrayView data, bool ninthBit);
+    bool isLineMarked() const { return lineErrorReporting || nineBitMode; }
+    qint64 unmarkLineErrors(char *data, qint64 size);
+    void emitLineErrors();
+
+    bool ioThreadEnabled = false;
+    QSerialPort::SchedulingPolicy ioThreadSchedulingPolicy = QSerialPort::DefaultScheduling;
+    int ioThreadPriority = 0;
+    QList<int> ioThreadCpus;
+    mutable QMutex latencyMutex;
+    QSerialPortLatencyStatistics latency;
+
+    // Transport of the port, QSerialPortNativeBackend unless the port name
+    // selects a registered scheme, see QSerialPortBackend
+    std::unique_ptr<QSerialPortBackend> backend;
+    bool backendReadScheduled = false;
+    bool backendReadBlocked = false;
+    bool backendWriteScheduled = false;
+
+    // Set while openDevice() runs on a worker thread of QSerialPort::openAll();
+    // the errors are reported from the thread of the port afterwards
+    bool errorsDeferred = false;
+    QList<QSerialPortErrorInfo> deferredErrors;
+
+    qint64 readBufferHighWatermark = 0;
+    qint64 readBufferLowWatermark = 0;
+    QSerialPort::FlowControl readBufferThrottling = QSerialPort::NoFlowControl;
+    bool readThrottled = false;
+
+    qint64 writeBufferMaxSize = 0;
+    QSerialPort::WriteBufferPolicy writeBufferPolicy = QSerialPort::RejectWhenFull;
+    int writeBufferTimeout = 30000;
+    bool writeBufferFullEmitted = false;
+    // Set by writeWhole() once the data was admitted to the bounded buffer
+    bool writeBufferBoundBypassed = false;
 
     void setBindableError(QSerialPort::SerialPortError error)
     { setError(error); }
@@ -167,6 +346,13 @@ public:
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(QSerialPortPrivate, bool, isBreakEnabled,
         &QSerialPortPrivate::setBindableBreakEnabled, false)
 
+    bool setBindableRs485Configuration(const QSerialPortRs485Configuration &configuration)
+    { return q_func()->setRs485Configuration(configuration); }
+    Q_OBJECT_COMPAT_PROPERTY(QSerialPortPrivate, QSerialPortRs485Configuration,
+        rs485Configuration, &QSerialPortPrivate::setBindableRs485Configuration)
+
+    bool setRs485Configuration(const QSerialPortRs485Configuration &configuration);
+
     bool startAsyncRead();
 
 #if defined(Q_OS_WIN32)
@@ -176,6 +362,7 @@ public:
     OVERLAPPED *waitForNotified(QDeadlineTimer deadline);
 
     qint64 queuedBytesCount(QSerialPort::Direction direction) const;
+    bool queryCommStatus(COMSTAT *comstat) const;
 
     bool completeAsyncCommunication(qint64 bytesTransferred);
     bool completeAsyncRead(qint64 bytesTransferred);
@@ -233,7 +420,28 @@ public:
     bool startAsyncWrite();
     bool completeAsyncWrite();
 
+    bool startIoThread();
+    void stopIoThread();
+    void runIoThread();
+    void wakeIoThread();
+    void scheduleIoThreadDelivery();
+    bool deliverIoThreadData();
+    bool waitForIoThreadData(int msecs);
+
+    bool setParityTermios(QSerialPort::Parity parity, bool lineErrors, bool nineBit);
+#ifdef CMSPAR
+    bool setStickyParity(bool mark);
+#endif
+
+    bool startBlockingMode();
+    qint64 readBlocking(char *data, qint64 maxSize);
+    qint64 writeBlocking(const char *data, qint64 maxSize);
+
     struct termios restoredTermios;
+#ifdef SER_RS485_ENABLED
+    // The RS-485 settings of the driver before setRs485Configuration()
+    std::optional<serial_rs485> restoredRs485;
+#endif
     int descriptor = -1;
 
     QSocketNotifier *readNotifier = nullptr;
@@ -249,8 +457,28 @@ public:
     qint64 pendingBytesWritten = 0;
     bool writeSequenceStarted = false;
 
+    // The descriptor is in blocking mode, see QSerialPort::setBlockingModeEnabled()
+    bool blockingModeActive = false;
+    // The previous blocking read returned data, see readBlocking()
+    bool blockingReadReturnedData = false;
+
     std::unique_ptr<QLockFile> lockFileScopedPointer;
 
+    // Reads from the descriptor when QSerialPort::setIoThreadEnabled() is
+    // set. The data is staged in ioStaged and handed over to the read buffer
+    // by deliverIoThreadData() in the thread of the serial port; everything
+    // below ioThread is guarded by ioMutex.
+    QThread *ioThread = nullptr;
+    int ioWakePipe[2] = { -1, -1 };
+    QMutex ioMutex;
+    QWaitCondition ioDataAvailable;
+    QRingBuffer ioStaged;
+    std::chrono::steady_clock::time_point ioStagedReadTime;
+    bool ioStopping = false;
+    bool ioDeliveryScheduled = false;
+    bool ioReadFailed = false;
+    int ioError = 0;
+
 #endif
 };
 
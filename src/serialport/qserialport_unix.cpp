@@ -4,18 +4,23 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qserialport_p.h"
+#include "qserialportcapture_p.h"
 #include "qserialportinfo_p.h"
 
 #include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qsemaphore.h>
 #include <QtCore/qsocketnotifier.h>
 #include <QtCore/qstandardpaths.h>
+#include <QtCore/qthread.h>
 
 #include <private/qcore_unix_p.h>
 
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
 #include <unistd.h>
@@ -234,6 +239,35 @@ static inline void qt_set_parity(termios *tio, QSerialPort::Parity parity)
     }
 }
 
+// Applied after qt_set_parity(): the driver marks characters received with
+// a parity or framing error and breaks instead of dropping them, and
+// escapes 0xFF data bytes
+static inline void qt_set_line_error_marking(termios *tio, bool enable, QSerialPort::Parity parity)
+{
+    if (!enable)
+        return;
+    tio->c_iflag &= ~(IGNPAR | IGNBRK | BRKINT | ISTRIP);
+    tio->c_iflag |= PARMRK;
+    if (parity != QSerialPort::NoParity)
+        tio->c_iflag |= INPCK;
+}
+
+// Applied last: 8 data bits with sticky parity, space at rest. Received
+// bytes with the 9th bit set fail the parity check and get marked.
+static inline void qt_set_nine_bit(termios *tio, bool enable)
+{
+#ifdef CMSPAR
+    if (!enable)
+        return;
+    tio->c_cflag &= ~(CSIZE | PARODD);
+    tio->c_cflag |= CS8 | PARENB | CMSPAR;
+    tio->c_iflag |= INPCK;
+#else
+    Q_UNUSED(tio);
+    Q_UNUSED(enable);
+#endif
+}
+
 static inline void qt_set_stopbits(termios *tio, QSerialPort::StopBits stopbits)
 {
     switch (stopbits) {
@@ -271,7 +305,7 @@ static inline void qt_set_flowcontrol(termios *tio, QSerialPort::FlowControl flo
     }
 }
 
-bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
+bool QSerialPortPrivate::openDevice(QIODevice::OpenMode mode)
 {
     QString lockFilePath = serialPortLockFilePath(QSerialPortInfoPrivate::portNameFromSystemLocation(systemLocation));
     bool isLockFileEmpty = lockFilePath.isEmpty();
@@ -319,10 +353,52 @@ bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
     return true;
 }
 
+bool QSerialPortPrivate::startNotifications(QIODevice::OpenMode mode)
+{
+    if (blockingModeEnabled) {
+        if (!startBlockingMode()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    if (mode & QIODevice::ReadOnly) {
+        if (ioThreadEnabled) {
+            if (!startIoThread()) {
+                close();
+                return false;
+            }
+        } else {
+            setReadNotificationEnabled(true);
+        }
+    }
+    return true;
+}
+
 void QSerialPortPrivate::close()
 {
-    if (settingsRestoredOnClose)
+    stopIoThread();
+
+    if (blockingModeActive) {
+        // Do not wait for the output to drain when closing
+        const int flags = ::fcntl(descriptor, F_GETFL);
+        if (flags != -1)
+            ::fcntl(descriptor, F_SETFL, flags | O_NONBLOCK);
+        blockingModeActive = false;
+        blockingReadReturnedData = false;
+    }
+
+    if (settingsRestoredOnClose) {
+#if defined(SER_RS485_ENABLED) && defined(TIOCSRS485)
+        if (restoredRs485)
+            ::ioctl(descriptor, TIOCSRS485, &*restoredRs485);
+#endif
         ::tcsetattr(descriptor, TCSANOW, &restoredTermios);
+    }
+#ifdef SER_RS485_ENABLED
+    restoredRs485.reset();
+#endif
 
 #ifdef TIOCNXCL
     ::ioctl(descriptor, TIOCNXCL);
@@ -422,6 +498,25 @@ bool QSerialPortPrivate::setRequestToSend(bool set)
     return true;
 }
 
+bool QSerialPortPrivate::throttleRead(bool throttle)
+{
+    switch (readBufferThrottling) {
+    case QSerialPort::HardwareControl:
+        // With hardware flow control the driver owns the RTS line
+        if (flowControl == QSerialPort::HardwareControl)
+            return true;
+        return setRequestToSend(!throttle);
+    case QSerialPort::SoftwareControl:
+        if (::tcflow(descriptor, throttle ? TCIOFF : TCION) == -1) {
+            setError(getSystemError());
+            return false;
+        }
+        return true;
+    default:
+        return true;
+    }
+}
+
 bool QSerialPortPrivate::flush()
 {
     return completeAsyncWrite();
@@ -435,6 +530,14 @@ bool QSerialPortPrivate::clear(QSerialPort::Directions directions)
         return false;
     }
 
+    if (ioThread && (directions & QSerialPort::Input)) {
+        QMutexLocker locker(&ioMutex);
+        const bool wasFull = ioStaged.size() >= QSERIALPORT_IOSTAGINGSIZE;
+        ioStaged.clear();
+        if (wasFull)
+            wakeIoThread();
+    }
+
     return true;
 }
 
@@ -460,6 +563,9 @@ bool QSerialPortPrivate::setBreakEnabled(bool set)
 
 bool QSerialPortPrivate::waitForReadyRead(int msecs)
 {
+    if (ioThread)
+        return waitForIoThreadData(msecs);
+
     QElapsedTimer stopWatch;
     stopWatch.start();
 
@@ -491,8 +597,10 @@ bool QSerialPortPrivate::waitForBytesWritten(int msecs)
     for (;;) {
         bool readyToRead = false;
         bool readyToWrite = false;
-        const bool checkRead = q_func()->isReadable();
-        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, checkRead, !writeBuffer.isEmpty(),
+        // The I/O thread does the reading, if any
+        const bool checkRead = q_func()->isReadable() && !ioThread;
+        const bool checkWrite = !writeBuffer.isEmpty() || pendingBytesWritten > 0;
+        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, checkRead, checkWrite,
                                 qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
             return false;
         }
@@ -685,21 +793,193 @@ bool QSerialPortPrivate::setDataBits(QSerialPort::DataBits dataBits)
         return false;
 
     qt_set_databits(&tio, dataBits);
+    qt_set_nine_bit(&tio, nineBitMode);
 
     return setTermios(&tio);
 }
 
 bool QSerialPortPrivate::setParity(QSerialPort::Parity parity)
+{
+    return setParityTermios(parity, lineErrorReporting, nineBitMode);
+}
+
+bool QSerialPortPrivate::setLineErrorReporting(bool enable)
+{
+    if (!setParityTermios(parity, enable, nineBitMode))
+        return false;
+    lineMarkState = 0;
+    return true;
+}
+
+bool QSerialPortPrivate::setNineBitMode(bool enable)
+{
+#ifdef CMSPAR
+    if (!setParityTermios(parity, lineErrorReporting, enable))
+        return false;
+    lineMarkState = 0;
+    return true;
+#else
+    Q_UNUSED(enable);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("9-bit mode is not supported")));
+    return false;
+#endif
+}
+
+// Applies the parity along with the line error marking and the 9-bit mode,
+// which both build on it
+bool QSerialPortPrivate::setParityTermios(QSerialPort::Parity parity, bool lineErrors, bool nineBit)
 {
     termios tio;
     if (!getTermios(&tio))
         return false;
 
+    // Leaving the 9-bit mode restores the data bits and the sticky parity
+#ifdef CMSPAR
+    tio.c_cflag &= ~CMSPAR;
+#endif
+    qt_set_databits(&tio, dataBits);
     qt_set_parity(&tio, parity);
+    qt_set_line_error_marking(&tio, lineErrors || nineBit, parity);
+    qt_set_nine_bit(&tio, nineBit);
 
     return setTermios(&tio);
 }
 
+/*
+    Writes \a data with the 9th bit set to \a ninthBit, as mark or space
+    parity. The parity changes with TCSADRAIN, once the data queued before
+    has been sent; after data with the 9th bit set, it goes back to space
+    parity for the received data.
+*/
+qint64 QSerialPortPrivate::writeNineBit(QByteArrayView data, bool ninthBit)
+{
+#ifdef CMSPAR
+    Q_Q(QSerialPort);
+
+    // Data written with write() goes out with the parity of the moment. Like
+    // the write below, this waits as long as it takes, see QSerialPort::writeNineBit()
+    while (!writeBuffer.isEmpty() || pendingBytesWritten > 0) {
+        if (!waitForBytesWritten(-1))
+            return -1;
+    }
+
+    if (ninthBit && !setStickyParity(true))
+        return -1;
+
+    qint64 written = 0;
+    while (written < data.size()) {
+        const qint64 bytes = writeToPort(data.data() + written, data.size() - written);
+        if (bytes < 0) {
+            bool readyToRead = false;
+            bool readyToWrite = false;
+            if (errno == EAGAIN
+                    && waitForReadOrWrite(&readyToRead, &readyToWrite, false, true, -1)) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                QSerialPortErrorInfo error = getSystemError();
+                error.errorCode = QSerialPort::WriteError;
+                setError(error);
+            }
+            break;
+        }
+        written += bytes;
+    }
+
+    if (ninthBit && !setStickyParity(false))
+        return -1;
+
+    if (written > 0 && !emittedBytesWritten) {
+        emittedBytesWritten = true;
+        emit q->bytesWritten(written);
+        emittedBytesWritten = false;
+    }
+    return written == data.size() ? written : qint64(-1);
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(ninthBit);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("9-bit mode is not supported")));
+    return -1;
+#endif
+}
+
+#ifdef CMSPAR
+bool QSerialPortPrivate::setStickyParity(bool mark)
+{
+    termios tio;
+    if (!getTermios(&tio))
+        return false;
+    if (mark)
+        tio.c_cflag |= PARODD;
+    else
+        tio.c_cflag &= ~PARODD;
+    if (::tcsetattr(descriptor, TCSADRAIN, &tio) == -1) {
+        setError(getSystemError());
+        return false;
+    }
+    return true;
+}
+#endif
+
+bool QSerialPortPrivate::setRs485Configuration(const QSerialPortRs485Configuration &configuration)
+{
+#if defined(SER_RS485_ENABLED) && defined(TIOCSRS485)
+    const auto setRs485Error = [this](int errorCode) {
+        if (errorCode == ENOTTY || errorCode == EINVAL || errorCode == EOPNOTSUPP) {
+            setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                          QSerialPort::tr("RS-485 mode is not supported")));
+        } else {
+            setError(getSystemError(errorCode));
+        }
+    };
+
+    serial_rs485 rs485;
+    ::memset(&rs485, 0, sizeof(rs485));
+    if (::ioctl(descriptor, TIOCGRS485, &rs485) == -1) {
+        // Nothing to disable
+        if (!configuration.isEnabled())
+            return true;
+        setRs485Error(errno);
+        return false;
+    }
+    if (!restoredRs485)
+        restoredRs485 = rs485;
+
+    rs485.flags &= ~(SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND | SER_RS485_RTS_AFTER_SEND
+                     | SER_RS485_RX_DURING_TX);
+    if (configuration.isEnabled())
+        rs485.flags |= SER_RS485_ENABLED;
+    if (configuration.isRequestToSendOnSend())
+        rs485.flags |= SER_RS485_RTS_ON_SEND;
+    if (configuration.isRequestToSendAfterSend())
+        rs485.flags |= SER_RS485_RTS_AFTER_SEND;
+    if (configuration.isReceiveDuringTransmitEnabled())
+        rs485.flags |= SER_RS485_RX_DURING_TX;
+    rs485.delay_rts_before_send = __u32(qMax<qint64>(0, configuration.delayBeforeSend().count()));
+    rs485.delay_rts_after_send = __u32(qMax<qint64>(0, configuration.delayAfterSend().count()));
+
+    if (::ioctl(descriptor, TIOCSRS485, &rs485) == -1) {
+        setRs485Error(errno);
+        return false;
+    }
+
+    // The driver returns what it applied, without the mode if it lacks it
+    if (configuration.isEnabled() && !(rs485.flags & SER_RS485_ENABLED)) {
+        setRs485Error(EOPNOTSUPP);
+        return false;
+    }
+    return true;
+#else
+    if (!configuration.isEnabled())
+        return true;
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("RS-485 mode is not supported")));
+    return false;
+#endif
+}
+
 bool QSerialPortPrivate::setStopBits(QSerialPort::StopBits stopBits)
 {
     termios tio;
@@ -724,6 +1004,12 @@ bool QSerialPortPrivate::setFlowControl(QSerialPort::FlowControl flowControl)
 
 bool QSerialPortPrivate::startAsyncRead()
 {
+    if (ioThread) {
+        QMutexLocker locker(&ioMutex);
+        scheduleIoThreadDelivery();
+        return true;
+    }
+
     setReadNotificationEnabled(true);
     return true;
 }
@@ -736,7 +1022,7 @@ bool QSerialPortPrivate::readNotification()
     qint64 newBytes = buffer.size();
     qint64 bytesToRead = QSERIALPORT_BUFFERSIZE;
 
-    if (readBufferMaxSize && bytesToRead > (readBufferMaxSize - buffer.size())) {
+    if (!isReadBufferBypassed() && readBufferMaxSize && bytesToRead > (readBufferMaxSize - buffer.size())) {
         bytesToRead = readBufferMaxSize - buffer.size();
         if (bytesToRead <= 0) {
             // Buffer is full. User must read data from the buffer
@@ -746,10 +1032,17 @@ bool QSerialPortPrivate::readNotification()
         }
     }
 
-    char *ptr = buffer.reserve(bytesToRead);
-    const qint64 readBytes = readFromPort(ptr, bytesToRead);
+    char *ptr = reserveRead(bytesToRead);
+    qint64 readBytes = readFromPort(ptr, bytesToRead);
+    // A read of nothing but line errors still counts
+    bool marksOnly = false;
+    if (isLineMarked() && readBytes > 0) {
+        readBytes = unmarkLineErrors(ptr, readBytes);
+        marksOnly = readBytes == 0;
+    }
 
-    buffer.chop(bytesToRead - qMax(readBytes, qint64(0)));
+    commitRead(ptr, bytesToRead, readBytes);
+    emitLineErrors();
 
     if (readBytes < 0) {
         QSerialPortErrorInfo error = getSystemError();
@@ -760,11 +1053,13 @@ bool QSerialPortPrivate::readNotification()
         setError(error);
         return false;
     } else if (readBytes == 0) {
-        return false;
+        return marksOnly;
     }
 
     newBytes = buffer.size() - newBytes;
 
+    checkReadBufferWatermarks();
+
     // only emit readyRead() when not recursing, and only if there is data available
     const bool hasData = newBytes > 0;
 
@@ -795,6 +1090,7 @@ bool QSerialPortPrivate::startAsyncWrite()
     writeBuffer.free(written);
     pendingBytesWritten += written;
     writeSequenceStarted = true;
+    checkWriteBufferDrained();
 
     if (!isWriteNotificationEnabled())
         setWriteNotificationEnabled(true);
@@ -818,12 +1114,326 @@ bool QSerialPortPrivate::completeAsyncWrite()
 
     if (writeBuffer.isEmpty()) {
         setWriteNotificationEnabled(false);
+        scheduleTransmitCheck();
         return true;
     }
 
     return startAsyncWrite();
 }
 
+static int applyIoThreadScheduling(QSerialPort::SchedulingPolicy policy, int priority,
+                                   const QList<int> &cpus)
+{
+    if (policy != QSerialPort::DefaultScheduling) {
+        sched_param param = {};
+        param.sched_priority = priority;
+        const int ret = ::pthread_setschedparam(::pthread_self(),
+                                                policy == QSerialPort::FifoScheduling
+                                                    ? SCHED_FIFO : SCHED_RR,
+                                                &param);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (!cpus.isEmpty()) {
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE)
+                return EINVAL;
+            CPU_SET(cpu, &set);
+        }
+        return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#else
+        return ENOTSUP;
+#endif
+    }
+
+    return 0;
+}
+
+bool QSerialPortPrivate::startIoThread()
+{
+    if (qt_safe_pipe(ioWakePipe, O_NONBLOCK) == -1) {
+        setError(getSystemError());
+        return false;
+    }
+
+    ioStaged.clear();
+    ioStopping = false;
+    ioDeliveryScheduled = false;
+    ioReadFailed = false;
+    ioError = 0;
+
+    // The scheduling can only be applied from within the thread; wait for
+    // the outcome so that open() can fail if it is not permitted.
+    QSemaphore started;
+    int startError = 0;
+    ioThread = QThread::create([this, &started, &startError]() {
+        startError = applyIoThreadScheduling(ioThreadSchedulingPolicy, ioThreadPriority,
+                                             ioThreadCpus);
+        const bool run = startError == 0;
+        started.release();
+        if (run)
+            runIoThread();
+    });
+    ioThread->setObjectName(QStringLiteral("QSerialPort I/O"));
+    ioThread->start();
+    started.acquire();
+
+    if (startError != 0) {
+        ioThread->wait();
+        delete ioThread;
+        ioThread = nullptr;
+        qt_safe_close(ioWakePipe[0]);
+        qt_safe_close(ioWakePipe[1]);
+        ioWakePipe[0] = ioWakePipe[1] = -1;
+        setError(getSystemError(startError));
+        return false;
+    }
+
+    return true;
+}
+
+void QSerialPortPrivate::stopIoThread()
+{
+    if (!ioThread)
+        return;
+
+    {
+        QMutexLocker locker(&ioMutex);
+        ioStopping = true;
+        wakeIoThread();
+    }
+    ioThread->wait();
+    delete ioThread;
+    ioThread = nullptr;
+
+    qt_safe_close(ioWakePipe[0]);
+    qt_safe_close(ioWakePipe[1]);
+    ioWakePipe[0] = ioWakePipe[1] = -1;
+
+    ioStaged.clear();
+    ioDeliveryScheduled = false;
+}
+
+void QSerialPortPrivate::wakeIoThread()
+{
+    const char c = 0;
+    qt_safe_write(ioWakePipe[1], &c, 1);
+}
+
+void QSerialPortPrivate::runIoThread()
+{
+    QByteArray chunk(QSERIALPORT_BUFFERSIZE, Qt::Uninitialized);
+    pollfd pfds[2] = {
+        qt_make_pollfd(descriptor, POLLIN),
+        qt_make_pollfd(ioWakePipe[0], POLLIN)
+    };
+
+    for (;;) {
+        {
+            QMutexLocker locker(&ioMutex);
+            if (ioStopping)
+                return;
+            // Stop polling the port while the staging area is full or an
+            // error waits to be reported, until woken up through the pipe
+            const bool paused = ioReadFailed || ioStaged.size() >= QSERIALPORT_IOSTAGINGSIZE;
+            pfds[0].fd = paused ? -1 : descriptor;
+        }
+
+        if (qt_safe_poll(pfds, 2, QDeadlineTimer::Forever) < 0) {
+            QMutexLocker locker(&ioMutex);
+            ioError = errno;
+            ioReadFailed = true;
+            scheduleIoThreadDelivery();
+            continue;
+        }
+        const auto wokenUp = std::chrono::steady_clock::now();
+
+        if (pfds[1].revents & POLLIN) {
+            char drain[64];
+            while (qt_safe_read(ioWakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        if (pfds[0].fd == -1 || pfds[0].revents == 0)
+            continue;
+
+        qint64 readBytes = 0;
+        int readError = 0;
+        if (pfds[0].revents & POLLNVAL) {
+            readBytes = -1;
+            readError = EBADF;
+        } else {
+            readBytes = qt_safe_read(descriptor, chunk.data(), chunk.size());
+            readError = errno;
+            // A hangup reads as end of file, there is nothing more to come
+            if (readBytes == 0 && (pfds[0].revents & POLLHUP)) {
+                readBytes = -1;
+                readError = EIO;
+            }
+        }
+        if (readBytes < 0 && readError == EAGAIN)
+            continue;
+
+        const auto readTime = std::chrono::steady_clock::now();
+        if (readBytes > 0)
+            recordWakeupToRead(std::chrono::nanoseconds(readTime - wokenUp).count());
+
+        QMutexLocker locker(&ioMutex);
+        if (readBytes < 0) {
+            ioError = readError;
+            ioReadFailed = true;
+        } else if (readBytes > 0) {
+            if (ioStaged.isEmpty())
+                ioStagedReadTime = readTime;
+            ioStaged.append(chunk.constData(), readBytes);
+        }
+        ioDataAvailable.wakeAll();
+        scheduleIoThreadDelivery();
+    }
+}
+
+// Called with ioMutex locked
+void QSerialPortPrivate::scheduleIoThreadDelivery()
+{
+    Q_Q(QSerialPort);
+
+    if (ioDeliveryScheduled || (ioStaged.isEmpty() && ioError == 0))
+        return;
+    ioDeliveryScheduled = true;
+    QMetaObject::invokeMethod(q, [this]() { deliverIoThreadData(); }, Qt::QueuedConnection);
+}
+
+bool QSerialPortPrivate::deliverIoThreadData()
+{
+    Q_Q(QSerialPort);
+
+    QMutexLocker locker(&ioMutex);
+    ioDeliveryScheduled = false;
+
+    const bool wasFull = ioStaged.size() >= QSERIALPORT_IOSTAGINGSIZE;
+    qint64 bytesToDeliver = 0;
+    char *ptr = nullptr;
+    QList<QByteArray> blocks;
+    if (isReadDataProcessed()) {
+        // The decompressor, the filters, the handler and the decoder get the
+        // staged blocks as they are; the read buffer size is only checked
+        // between blocks
+        const bool limited = readBufferMaxSize && !isReadBufferBypassed();
+        while (!ioStaged.isEmpty()
+               && (!limited || buffer.size() + bytesToDeliver < readBufferMaxSize)) {
+            bytesToDeliver += ioStaged.nextDataBlockSize();
+            blocks.append(ioStaged.read());
+        }
+    } else {
+        bytesToDeliver = ioStaged.size();
+        if (readBufferMaxSize)
+            bytesToDeliver = qMin(bytesToDeliver, qMax(readBufferMaxSize - buffer.size(), qint64(0)));
+        if (bytesToDeliver > 0) {
+            ptr = buffer.reserve(bytesToDeliver);
+            ioStaged.read(ptr, bytesToDeliver);
+        }
+    }
+    const auto readTime = ioStagedReadTime;
+
+    // Errors are reported once the data read before them is delivered
+    int error = 0;
+    if (ioStaged.isEmpty() && ioError != 0) {
+        error = std::exchange(ioError, 0);
+        const QSerialPortErrorInfo info = getSystemError(error);
+        // Keep on reading after a plain read error only
+        if (info.errorCode != QSerialPort::ResourceError) {
+            ioReadFailed = false;
+            wakeIoThread();
+        }
+    }
+    if (wasFull && ioStaged.size() < QSERIALPORT_IOSTAGINGSIZE)
+        wakeIoThread();
+    locker.unlock();
+
+    qint64 newBytes = 0;
+    if (!blocks.isEmpty()) {
+        recordReadToDeliver(std::chrono::nanoseconds(
+                                std::chrono::steady_clock::now() - readTime).count());
+        for (QByteArray &block : blocks) {
+            if (isLineMarked())
+                block.truncate(unmarkLineErrors(block.data(), block.size()));
+            if (captureDevice && !block.isEmpty())
+                captureRecord(QSerialPortCapture::ReadRecord, block.constData(), block.size());
+            newBytes += receiveReadData(block);
+        }
+    } else if (bytesToDeliver > 0) {
+        newBytes = bytesToDeliver;
+        if (isLineMarked()) {
+            newBytes = unmarkLineErrors(ptr, bytesToDeliver);
+            buffer.chop(bytesToDeliver - newBytes);
+        }
+        if (captureDevice && newBytes > 0)
+            captureRecord(QSerialPortCapture::ReadRecord, ptr, newBytes);
+        recordReadToDeliver(std::chrono::nanoseconds(
+                                std::chrono::steady_clock::now() - readTime).count());
+    }
+    emitLineErrors();
+
+    if (newBytes > 0) {
+        checkReadBufferWatermarks();
+
+        if (!emittedReadyRead) {
+            emittedReadyRead = true;
+            emit q->readyRead();
+            emittedReadyRead = false;
+        }
+    }
+
+    if (error != 0) {
+        QSerialPortErrorInfo info = getSystemError(error);
+        if (info.errorCode != QSerialPort::ResourceError)
+            info.errorCode = QSerialPort::ReadError;
+        setError(info);
+    }
+
+    return bytesToDeliver > 0;
+}
+
+bool QSerialPortPrivate::waitForIoThreadData(int msecs)
+{
+    const QDeadlineTimer deadline(msecs);
+
+    for (;;) {
+        // Keep the pending writes going while waiting for the I/O thread
+        const bool writing = !writeBuffer.isEmpty() || writeSequenceStarted;
+        if (writing) {
+            pollfd pfd = qt_make_pollfd(descriptor, POLLOUT);
+            if (qt_safe_poll(&pfd, 1, QDeadlineTimer(0)) > 0 && (pfd.revents & POLLOUT)
+                    && !completeAsyncWrite()) {
+                return false;
+            }
+        }
+
+        {
+            QMutexLocker locker(&ioMutex);
+            const auto pending = [this]() { return !ioStaged.isEmpty() || ioError != 0; };
+            if (!pending()) {
+                ioDataAvailable.wait(&ioMutex, writing
+                                     ? qMin(deadline, QDeadlineTimer(QSERIALPORT_IOWRITEPOLLINTERVAL))
+                                     : deadline);
+            }
+            if (pending()) {
+                locker.unlock();
+                return deliverIoThreadData();
+            }
+        }
+
+        if (deadline.hasExpired()) {
+            setError(QSerialPortErrorInfo(QSerialPort::TimeoutError));
+            return false;
+        }
+    }
+}
+
 inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
 {
 #ifdef TIOCEXCL
@@ -840,8 +1450,10 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     qt_set_common_props(&tio, mode);
     qt_set_databits(&tio, dataBits);
     qt_set_parity(&tio, parity);
+    qt_set_line_error_marking(&tio, lineErrorReporting || nineBitMode, parity);
     qt_set_stopbits(&tio, stopBits);
     qt_set_flowcontrol(&tio, flowControl);
+    qt_set_nine_bit(&tio, nineBitMode);
 
     if (!setTermios(&tio))
         return false;
@@ -849,8 +1461,9 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     if (!setBaudRate())
         return false;
 
-    if (mode & QIODevice::ReadOnly)
-        setReadNotificationEnabled(true);
+    const QSerialPortRs485Configuration rs485 = rs485Configuration;
+    if (rs485.isEnabled() && !setRs485Configuration(rs485))
+        return false;
 
     // flush IO buffers
     clear(QSerialPort::AllDirections);
@@ -858,14 +1471,189 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     return true;
 }
 
+/*
+    Switches the descriptor to blocking mode. A read returns once it got
+    the bytes asked for, or with the bytes received so far when the line
+    has been quiet for the inter-byte timeout; the kernel limits both to
+    255 bytes and 25.5 seconds. Without the timeout, a read returns as soon
+    as there is any data.
+*/
+bool QSerialPortPrivate::startBlockingMode()
+{
+    const int flags = ::fcntl(descriptor, F_GETFL);
+    if (flags == -1 || ::fcntl(descriptor, F_SETFL, flags & ~O_NONBLOCK) == -1) {
+        setError(getSystemError());
+        return false;
+    }
+
+    termios tio;
+    if (!getTermios(&tio))
+        return false;
+    const int deciseconds = qMin((interByteTimeout + 99) / 100, 255);
+    tio.c_cc[VMIN] = deciseconds > 0 ? 255 : 1;
+    tio.c_cc[VTIME] = cc_t(deciseconds);
+    if (!setTermios(&tio))
+        return false;
+
+    // QSerialPort opens the QIODevice unbuffered, so that it passes the
+    // buffer of the caller to readData()
+    blockingModeActive = true;
+    blockingReadReturnedData = false;
+    return true;
+}
+
+/*
+    A read() is one blocking read. Once a read returned data, the next one
+    only takes data that is pending already and returns 0 otherwise, so
+    that readAll() and loops reading until nothing is left come back; the
+    read after that blocks again.
+*/
+qint64 QSerialPortPrivate::readBlocking(char *data, qint64 maxSize)
+{
+    if (std::exchange(blockingReadReturnedData, false)) {
+        pollfd pfd = qt_make_pollfd(descriptor, POLLIN);
+        if (qt_safe_poll(&pfd, 1, QDeadlineTimer(0)) <= 0)
+            return 0;
+    }
+
+    if (isReadDataProcessed()) {
+        // The data passes the decompressor, the filters, the handler or the
+        // decoder on its way, whatever is left is read from the read buffer
+        readNotification();
+        const qint64 readBytes = buffer.read(data, maxSize);
+        blockingReadReturnedData = readBytes > 0;
+        return readBytes;
+    }
+
+    qint64 readBytes = readFromPort(data, maxSize);
+    if (isLineMarked() && readBytes > 0) {
+        readBytes = unmarkLineErrors(data, readBytes);
+        emitLineErrors();
+    }
+    if (readBytes < 0) {
+        QSerialPortErrorInfo error = getSystemError();
+        if (error.errorCode != QSerialPort::ResourceError)
+            error.errorCode = QSerialPort::ReadError;
+        setError(error);
+        return -1;
+    }
+    if (readBytes > 0 && captureDevice)
+        captureRecord(QSerialPortCapture::ReadRecord, data, readBytes);
+    blockingReadReturnedData = readBytes > 0;
+    return readBytes;
+}
+
+qint64 QSerialPortPrivate::writeBlocking(const char *data, qint64 maxSize)
+{
+    Q_Q(QSerialPort);
+
+    // QSerialPort::writeFrame() encodes into the write buffer, which is
+    // written first
+    qint64 written = 0;
+    qint64 bytes = 0;
+    while (!writeBuffer.isEmpty() && bytes >= 0) {
+        bytes = writeToPort(writeBuffer.readPointer(), writeBuffer.nextDataBlockSize());
+        if (bytes > 0) {
+            writeBuffer.free(bytes);
+            written += bytes;
+        }
+    }
+    for (qint64 offset = 0; offset < maxSize && bytes >= 0; offset += bytes) {
+        bytes = writeToPort(data + offset, maxSize - offset);
+        if (bytes > 0)
+            written += bytes;
+    }
+
+    QSerialPortErrorInfo error;
+    if (bytes < 0) {
+        error = getSystemError();
+        error.errorCode = QSerialPort::WriteError;
+    }
+
+    if (written > 0 && !emittedBytesWritten) {
+        emittedBytesWritten = true;
+        emit q->bytesWritten(written);
+        emittedBytesWritten = false;
+    }
+
+    if (bytes < 0) {
+        setError(error);
+        return -1;
+    }
+    scheduleTransmitCheck();
+    return maxSize;
+}
+
 qint64 QSerialPortPrivate::writeData(const char *data, qint64 maxSize)
 {
+    if (blockingModeActive)
+        return writeBlocking(data, maxSize);
+
+    if (immediateWrite && writeBuffer.isEmpty() && !writeSequenceStarted) {
+        qint64 written = writeToPort(data, maxSize);
+        if (written < 0) {
+            QSerialPortErrorInfo error = getSystemError();
+            if (error.errorCode != QSerialPort::ResourceError) {
+                error.errorCode = QSerialPort::WriteError;
+                setError(error);
+                return -1;
+            }
+            // The driver queue is full, buffer everything.
+            written = 0;
+        }
+
+        if (written > 0) {
+            // The bytesWritten() signal is emitted by completeAsyncWrite(),
+            // as for the data passed to the driver by startAsyncWrite().
+            pendingBytesWritten += written;
+            writeSequenceStarted = true;
+            data += written;
+        }
+
+        if (written < maxSize)
+            writeBuffer.append(data, maxSize - written);
+        if (!isWriteNotificationEnabled())
+            setWriteNotificationEnabled(true);
+        return maxSize;
+    }
+
     writeBuffer.append(data, maxSize);
     if (!writeBuffer.isEmpty() && !isWriteNotificationEnabled())
         setWriteNotificationEnabled(true);
     return maxSize;
 }
 
+QSerialPort::DriverQueueSizes QSerialPortPrivate::driverQueueSizes()
+{
+    int input = 0;
+    int output = 0;
+    if (::ioctl(descriptor, FIONREAD, &input) == -1
+            || ::ioctl(descriptor, TIOCOUTQ, &output) == -1) {
+        setError(getSystemError());
+        return {};
+    }
+    return { input, output };
+}
+
+qint64 QSerialPortPrivate::transmitQueueSize(std::optional<bool> *transmitterEmpty)
+{
+    int queued = 0;
+    if (::ioctl(descriptor, TIOCOUTQ, &queued) == -1) {
+        setError(getSystemError());
+        return -1;
+    }
+#if defined(TIOCSERGETLSR) && defined(TIOCSER_TEMT)
+    // The line status register of the UART tells whether its FIFO and its
+    // shift register are empty; USB adapters mostly do not support it
+    unsigned int lsr = 0;
+    if (::ioctl(descriptor, TIOCSERGETLSR, &lsr) != -1)
+        *transmitterEmpty = (lsr & TIOCSER_TEMT) != 0;
+#else
+    Q_UNUSED(transmitterEmpty);
+#endif
+    return queued;
+}
+
 bool QSerialPortPrivate::setTermios(const termios *tio)
 {
     if (::tcsetattr(descriptor, TCSANOW, tio) == -1) {
@@ -941,6 +1729,11 @@ QSerialPortErrorInfo QSerialPortPrivate::getSystemError(int systemErrorCode) con
     case EPERM:
         error.errorCode = QSerialPort::PermissionError;
         break;
+#endif
+#ifdef ENOTSUP
+    case ENOTSUP:
+        error.errorCode = QSerialPort::UnsupportedOperationError;
+        break;
 #endif
     default:
         error.errorCode = QSerialPort::UnknownError;
@@ -1036,6 +1829,9 @@ qint64 QSerialPortPrivate::writeToPort(const char *data, qint64 maxSize)
     }
 #endif
 
+    if (bytesWritten > 0 && captureDevice)
+        captureRecord(QSerialPortCapture::WriteRecord, data, bytesWritten);
+
     return bytesWritten;
 }
 
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qserialport_p.h"
+#include "qserialportcapture_p.h"
 #include "qwinoverlappedionotifier_p.h"
 
 #include <QtCore/qcoreevent.h>
@@ -138,7 +139,7 @@ static inline void qt_set_flowcontrol(DCB *dcb, QSerialPort::FlowControl flowcon
     }
 }
 
-bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
+bool QSerialPortPrivate::openDevice(QIODevice::OpenMode mode)
 {
     DWORD desiredAccess = 0;
 
@@ -159,9 +160,31 @@ bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
         return true;
 
     ::CloseHandle(handle);
+    handle = INVALID_HANDLE_VALUE;
     return false;
 }
 
+bool QSerialPortPrivate::startNotifications(QIODevice::OpenMode mode)
+{
+    Q_Q(QSerialPort);
+
+    notifier = new QWinOverlappedIoNotifier(q);
+    QObjectPrivate::connect(notifier, &QWinOverlappedIoNotifier::notified,
+               this, &QSerialPortPrivate::_q_notified);
+    notifier->setHandle(handle);
+    notifier->setEnabled(true);
+
+    if ((mode & QIODevice::ReadOnly) && !startAsyncCommunication()) {
+        delete notifier;
+        notifier = nullptr;
+        ::CloseHandle(handle);
+        handle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+
+    return true;
+}
+
 void QSerialPortPrivate::close()
 {
     ::CancelIo(handle);
@@ -252,6 +275,29 @@ bool QSerialPortPrivate::setRequestToSend(bool set)
     return setDcb(&dcb);
 }
 
+bool QSerialPortPrivate::throttleRead(bool throttle)
+{
+    switch (readBufferThrottling) {
+    case QSerialPort::HardwareControl:
+        // With hardware flow control the driver owns the RTS line
+        if (flowControl == QSerialPort::HardwareControl)
+            return true;
+        if (!::EscapeCommFunction(handle, throttle ? CLRRTS : SETRTS)) {
+            setError(getSystemError());
+            return false;
+        }
+        return true;
+    case QSerialPort::SoftwareControl:
+        if (!::TransmitCommChar(handle, throttle ? 0x13 : 0x11)) {
+            setError(getSystemError());
+            return false;
+        }
+        return true;
+    default:
+        return true;
+    }
+}
+
 bool QSerialPortPrivate::flush()
 {
     return _q_startAsyncWrite();
@@ -436,8 +482,11 @@ bool QSerialPortPrivate::completeAsyncRead(qint64 bytesTransferred)
         readStarted = false;
         return false;
     }
-    if (bytesTransferred > 0)
-        buffer.append(readChunkBuffer.constData(), bytesTransferred);
+    qint64 newBytes = 0;
+    if (bytesTransferred > 0) {
+        newBytes = appendReadChunk(std::exchange(readChunkBuffer, QByteArray()), bytesTransferred);
+        checkReadBufferWatermarks();
+    }
 
     readStarted = false;
 
@@ -449,7 +498,7 @@ bool QSerialPortPrivate::completeAsyncRead(qint64 bytesTransferred)
         result = startAsyncCommunication();
     }
 
-    if (bytesTransferred > 0)
+    if (newBytes > 0)
         emitReadyRead();
 
     return result;
@@ -459,6 +508,7 @@ bool QSerialPortPrivate::completeAsyncWrite(qint64 bytesTransferred)
 {
     Q_Q(QSerialPort);
 
+    const bool completed = writeStarted;
     if (writeStarted) {
         if (bytesTransferred == qint64(-1)) {
             writeChunkBuffer.clear();
@@ -466,12 +516,19 @@ bool QSerialPortPrivate::completeAsyncWrite(qint64 bytesTransferred)
             return false;
         }
         Q_ASSERT(bytesTransferred == writeChunkBuffer.size());
+        if (captureDevice)
+            captureRecord(QSerialPortCapture::WriteRecord, writeChunkBuffer.constData(),
+                          bytesTransferred);
         writeChunkBuffer.clear();
         emit q->bytesWritten(bytesTransferred);
         writeStarted = false;
     }
 
-    return _q_startAsyncWrite();
+    if (!_q_startAsyncWrite())
+        return false;
+    if (completed && !writeStarted)
+        scheduleTransmitCheck();
+    return true;
 }
 
 bool QSerialPortPrivate::startAsyncCommunication()
@@ -500,7 +557,7 @@ bool QSerialPortPrivate::startAsyncRead()
 
     qint64 bytesToRead = QSERIALPORT_BUFFERSIZE;
 
-    if (readBufferMaxSize && bytesToRead > (readBufferMaxSize - buffer.size())) {
+    if (!isReadBufferBypassed() && readBufferMaxSize && bytesToRead > (readBufferMaxSize - buffer.size())) {
         bytesToRead = readBufferMaxSize - buffer.size();
         if (bytesToRead <= 0) {
             // Buffer is full. User must read data from the buffer
@@ -509,6 +566,9 @@ bool QSerialPortPrivate::startAsyncRead()
         }
     }
 
+    if (readChunkBuffer.isNull())
+        readChunkBuffer = takeReadChunk();
+
     Q_ASSERT(int(bytesToRead) <= readChunkBuffer.size());
 
     ::ZeroMemory(&readCompletionOverlapped, sizeof(readCompletionOverlapped));
@@ -543,6 +603,7 @@ bool QSerialPortPrivate::_q_startAsyncWrite()
         return true;
 
     writeChunkBuffer = writeBuffer.read();
+    checkWriteBufferDrained();
     ::ZeroMemory(&writeCompletionOverlapped, sizeof(writeCompletionOverlapped));
     if (!::WriteFile(handle, writeChunkBuffer.constData(),
                      writeChunkBuffer.size(), nullptr, &writeCompletionOverlapped)) {
@@ -589,6 +650,15 @@ qint64 QSerialPortPrivate::writeData(const char *data, qint64 maxSize)
 {
     Q_Q(QSerialPort);
 
+    if (immediateWrite && writeBuffer.isEmpty() && !writeStarted) {
+        // Start the overlapped write right away, the completion is still
+        // reported asynchronously through the bytesWritten() signal.
+        writeBuffer.append(data, maxSize);
+        if (!_q_startAsyncWrite())
+            return -1;
+        return maxSize;
+    }
+
     writeBuffer.append(data, maxSize);
 
     if (!writeBuffer.isEmpty() && !writeStarted) {
@@ -613,19 +683,80 @@ OVERLAPPED *QSerialPortPrivate::waitForNotified(QDeadlineTimer deadline)
     return overlapped;
 }
 
+bool QSerialPortPrivate::queryCommStatus(COMSTAT *comstat) const
+{
+    return ::ClearCommError(handle, nullptr, comstat) != 0;
+}
+
 qint64 QSerialPortPrivate::queuedBytesCount(QSerialPort::Direction direction) const
 {
     COMSTAT comstat;
-    if (::ClearCommError(handle, nullptr, &comstat) == 0)
+    if (!queryCommStatus(&comstat))
         return -1;
     return (direction == QSerialPort::Input)
             ? comstat.cbInQue
             : ((direction == QSerialPort::Output) ? comstat.cbOutQue : -1);
 }
 
+QSerialPort::DriverQueueSizes QSerialPortPrivate::driverQueueSizes()
+{
+    // Both sizes from one query, so that they are taken at the same time
+    COMSTAT comstat;
+    if (!queryCommStatus(&comstat)) {
+        setError(getSystemError());
+        return {};
+    }
+    return { qint64(comstat.cbInQue), qint64(comstat.cbOutQue) };
+}
+
+bool QSerialPortPrivate::setLineErrorReporting(bool enable)
+{
+    Q_UNUSED(enable);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("Line error reporting is not supported")));
+    return false;
+}
+
+bool QSerialPortPrivate::setRs485Configuration(const QSerialPortRs485Configuration &configuration)
+{
+    if (!configuration.isEnabled())
+        return true;
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("RS-485 mode is not supported")));
+    return false;
+}
+
+bool QSerialPortPrivate::setNineBitMode(bool enable)
+{
+    Q_UNUSED(enable);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("9-bit mode is not supported")));
+    return false;
+}
+
+qint64 QSerialPortPrivate::writeNineBit(QByteArrayView data, bool ninthBit)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(ninthBit);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("9-bit mode is not supported")));
+    return -1;
+}
+
+qint64 QSerialPortPrivate::transmitQueueSize(std::optional<bool> *transmitterEmpty)
+{
+    // The state of the UART itself is not available
+    Q_UNUSED(transmitterEmpty);
+    const qint64 queued = queuedBytesCount(QSerialPort::Output);
+    if (queued < 0)
+        setError(getSystemError());
+    return queued;
+}
+
 inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
 {
-    Q_Q(QSerialPort);
+    if (!setRs485Configuration(rs485Configuration))
+        return false;
 
     DCB dcb;
     if (!getDcb(&dcb))
@@ -662,18 +793,6 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
         return false;
     }
 
-    notifier = new QWinOverlappedIoNotifier(q);
-    QObjectPrivate::connect(notifier, &QWinOverlappedIoNotifier::notified,
-               this, &QSerialPortPrivate::_q_notified);
-    notifier->setHandle(handle);
-    notifier->setEnabled(true);
-
-    if ((eventMask & EV_RXCHAR) && !startAsyncCommunication()) {
-        delete notifier;
-        notifier = nullptr;
-        return false;
-    }
-
     return true;
 }
 
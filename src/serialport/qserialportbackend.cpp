@@ -0,0 +1,807 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportbackend_p.h"
+#include "qserialport_p.h"
+#include "qserialportcapture_p.h"
+#ifdef Q_OS_UNIX
+#include "qserialportrfc2217_p.h"
+#endif
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <private/qringbuffer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Loops written data back to the read side without any system calls, as
+// a loopback plug would. DTR is wired to DSR and DCD, and RTS to CTS.
+class QSerialPortLoopbackBackend final : public QSerialPortBackend
+{
+public:
+    bool open(QIODevice::OpenMode mode) override
+    {
+        Q_UNUSED(mode);
+        return true;
+    }
+
+    void close() override
+    {
+        buffer.clear();
+    }
+
+    qint64 read(char *data, qint64 maxSize) override
+    {
+        return buffer.read(data, maxSize);
+    }
+
+    qint64 write(const char *data, qint64 maxSize) override
+    {
+        if (breakEnabled)
+            return maxSize;
+        const bool wasEmpty = buffer.isEmpty();
+        buffer.append(data, maxSize);
+        if (wasEmpty)
+            readyRead();
+        return maxSize;
+    }
+
+    bool waitForReadyRead(QDeadlineTimer deadline) override
+    {
+        Q_UNUSED(deadline);
+        return !buffer.isEmpty();
+    }
+
+    QSerialPort::PinoutSignals pinoutSignals() override
+    {
+        QSerialPort::PinoutSignals pinout;
+        if (dataTerminalReady) {
+            pinout |= QSerialPort::DataTerminalReadySignal | QSerialPort::DataSetReadySignal
+                    | QSerialPort::DataCarrierDetectSignal;
+        }
+        if (requestToSend)
+            pinout |= QSerialPort::RequestToSendSignal | QSerialPort::ClearToSendSignal;
+        return pinout;
+    }
+
+    bool setDataTerminalReady(bool set) override
+    {
+        dataTerminalReady = set;
+        return true;
+    }
+
+    bool setRequestToSend(bool set) override
+    {
+        requestToSend = set;
+        return true;
+    }
+
+    bool setBreakEnabled(bool set) override
+    {
+        breakEnabled = set;
+        return true;
+    }
+
+    bool clear(QSerialPort::Directions directions) override
+    {
+        if (directions & QSerialPort::Input)
+            buffer.clear();
+        return true;
+    }
+
+private:
+    QRingBuffer buffer;
+    bool dataTerminalReady = false;
+    bool requestToSend = false;
+    bool breakEnabled = false;
+};
+
+struct QSerialPortBackendRegistry
+{
+    QSerialPortBackendRegistry()
+    {
+        factories.insert(QStringLiteral("loopback"), [](const QString &) {
+            return std::unique_ptr<QSerialPortBackend>(new QSerialPortLoopbackBackend);
+        });
+#ifdef Q_OS_UNIX
+        factories.insert(QStringLiteral("rfc2217"), [](const QString &location) {
+            return std::unique_ptr<QSerialPortBackend>(new QSerialPortRfc2217Backend(location));
+        });
+#endif
+    }
+
+    QMutex mutex;
+    QHash<QString, QSerialPortBackend::Factory> factories;
+};
+
+} // namespace
+
+Q_GLOBAL_STATIC(QSerialPortBackendRegistry, backendRegistry)
+
+/*!
+    \class QSerialPortBackend
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief The QSerialPortBackend class is the transport underneath a
+    QSerialPort.
+
+    By default, QSerialPort uses the serial port of the platform. A port
+    name of the form \c{scheme://location} selects the backend registered
+    for \c scheme with registerBackend() instead, so that the complete
+    QSerialPort stack, including its buffers, filters, compression and
+    framing, runs on top of another transport: an in-memory device, a
+    recorded trace or a remote port. The schemes \c loopback, which loops
+    the written data back to the read side without any system calls, and
+    \c rfc2217 on Unix, for network device servers, are built in.
+
+    A backend is created when the serial port is opened. All functions are
+    called in the thread of the QSerialPort, and read() and write() must
+    not block. A backend calls readyRead() when new data can be read, and
+    readyWrite() when it can take more data after write() returned less
+    than requested.
+
+    The settings of the serial port are applied with setBaudRate(),
+    setDataBits(), setParity(), setStopBits() and setFlowControl() after
+    open(), and whenever they change. Their default implementations accept
+    any setting. Line error reporting, the 9-bit mode, RS-485, the driver
+    queue sizes and waitForTransmitComplete() are only supported by the
+    serial port of the platform.
+*/
+
+/*!
+    \typealias QSerialPortBackend::Factory
+
+    A function that creates a backend for the location of a port name, the
+    part after \c{scheme://}. It may return \nullptr to use the serial port
+    of the platform.
+*/
+
+/*!
+    \fn bool QSerialPortBackend::open(QIODevice::OpenMode mode)
+
+    Opens the transport in \a mode. Returns \c true on success; otherwise
+    sets an error with setError() and returns \c false.
+*/
+
+/*!
+    \fn void QSerialPortBackend::close()
+
+    Closes the transport.
+*/
+
+/*!
+    \fn qint64 QSerialPortBackend::read(char *data, qint64 maxSize)
+
+    Reads at most \a maxSize bytes into \a data without blocking. Returns
+    the number of bytes read, 0 if no data is available, or -1 on error.
+*/
+
+/*!
+    \fn qint64 QSerialPortBackend::write(const char *data, qint64 maxSize)
+
+    Writes at most \a maxSize bytes from \a data without blocking. Returns
+    the number of bytes taken, or -1 on error. If fewer bytes than
+    requested are taken, the backend calls readyWrite() once it can take
+    more.
+*/
+
+/*!
+    Constructs a backend.
+*/
+QSerialPortBackend::QSerialPortBackend() = default;
+
+/*!
+    Destroys the backend.
+*/
+QSerialPortBackend::~QSerialPortBackend() = default;
+
+/*!
+    Blocks until data can be read or \a deadline expires. Returns \c true
+    if data can be read. The default implementation returns \c false.
+*/
+bool QSerialPortBackend::waitForReadyRead(QDeadlineTimer deadline)
+{
+    Q_UNUSED(deadline);
+    return false;
+}
+
+/*!
+    Blocks until the transport can take more data or \a deadline expires.
+    Returns \c true if it can. The default implementation returns \c false.
+*/
+bool QSerialPortBackend::waitForWritable(QDeadlineTimer deadline)
+{
+    Q_UNUSED(deadline);
+    return false;
+}
+
+/*!
+    Sets the \a baudRate for \a directions. The default implementation
+    returns \c true.
+*/
+bool QSerialPortBackend::setBaudRate(qint32 baudRate, QSerialPort::Directions directions)
+{
+    Q_UNUSED(baudRate);
+    Q_UNUSED(directions);
+    return true;
+}
+
+/*!
+    Sets the \a dataBits. The default implementation returns \c true.
+*/
+bool QSerialPortBackend::setDataBits(QSerialPort::DataBits dataBits)
+{
+    Q_UNUSED(dataBits);
+    return true;
+}
+
+/*!
+    Sets the \a parity. The default implementation returns \c true.
+*/
+bool QSerialPortBackend::setParity(QSerialPort::Parity parity)
+{
+    Q_UNUSED(parity);
+    return true;
+}
+
+/*!
+    Sets the \a stopBits. The default implementation returns \c true.
+*/
+bool QSerialPortBackend::setStopBits(QSerialPort::StopBits stopBits)
+{
+    Q_UNUSED(stopBits);
+    return true;
+}
+
+/*!
+    Sets the \a flowControl. The default implementation returns \c true.
+*/
+bool QSerialPortBackend::setFlowControl(QSerialPort::FlowControl flowControl)
+{
+    Q_UNUSED(flowControl);
+    return true;
+}
+
+/*!
+    Returns the state of the line signals. The default implementation
+    returns QSerialPort::NoSignal.
+*/
+QSerialPort::PinoutSignals QSerialPortBackend::pinoutSignals()
+{
+    return QSerialPort::NoSignal;
+}
+
+/*!
+    Sets the DTR line to \a set. The default implementation sets the
+    QSerialPort::UnsupportedOperationError error and returns \c false.
+*/
+bool QSerialPortBackend::setDataTerminalReady(bool set)
+{
+    Q_UNUSED(set);
+    setError(QSerialPort::UnsupportedOperationError);
+    return false;
+}
+
+/*!
+    Sets the RTS line to \a set. The default implementation sets the
+    QSerialPort::UnsupportedOperationError error and returns \c false.
+*/
+bool QSerialPortBackend::setRequestToSend(bool set)
+{
+    Q_UNUSED(set);
+    setError(QSerialPort::UnsupportedOperationError);
+    return false;
+}
+
+/*!
+    Puts the transmission line in break if \a set is \c true. The default
+    implementation sets the QSerialPort::UnsupportedOperationError error
+    and returns \c false.
+*/
+bool QSerialPortBackend::setBreakEnabled(bool set)
+{
+    Q_UNUSED(set);
+    setError(QSerialPort::UnsupportedOperationError);
+    return false;
+}
+
+/*!
+    Sends the data the transport holds without blocking, after QSerialPort
+    has written its write buffer with write(). The default implementation
+    returns \c true.
+*/
+bool QSerialPortBackend::flush()
+{
+    return true;
+}
+
+/*!
+    Discards the data the transport holds for \a directions. The default
+    implementation returns \c true.
+*/
+bool QSerialPortBackend::clear(QSerialPort::Directions directions)
+{
+    Q_UNUSED(directions);
+    return true;
+}
+
+bool QSerialPortBackend::openDevice(QIODevice::OpenMode mode)
+{
+    // QSerialPort::openAll() may call this on a worker thread; a backend
+    // is opened in the thread of the port, by startDevice()
+    Q_UNUSED(mode);
+    return true;
+}
+
+bool QSerialPortBackend::startDevice(QIODevice::OpenMode mode)
+{
+    if (!open(mode)) {
+        if (d->error.valueBypassingBindings() == QSerialPort::NoError)
+            setError(QSerialPort::OpenError);
+        return false;
+    }
+
+    if (setBaudRate(d->inputBaudRate, QSerialPort::Input)
+            && setBaudRate(d->outputBaudRate, QSerialPort::Output)
+            && setDataBits(d->dataBits)
+            && setParity(d->parity)
+            && setStopBits(d->stopBits)
+            && setFlowControl(d->flowControl)) {
+        return true;
+    }
+
+    close();
+    return false;
+}
+
+qint64 QSerialPortBackend::queueWrite(const char *data, qint64 maxSize)
+{
+    d->writeBuffer.append(data, maxSize);
+    if (!d->writeBuffer.isEmpty())
+        d->scheduleBackendWrite();
+    return maxSize;
+}
+
+bool QSerialPortBackend::flushWriteBuffer()
+{
+    return writeNotification() >= 0 && flush();
+}
+
+qint64 QSerialPortBackend::readData(char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    // The application consumed data, release a throttled sender if the
+    // buffer dropped to the low watermark.
+    d->checkReadBufferWatermarks();
+
+    // Reading stops while the read buffer is full, continue
+    resumeRead();
+
+    // return 0 indicating there may be more data in the future
+    return qint64(0);
+}
+
+void QSerialPortBackend::resumeRead()
+{
+    if (d->backendReadBlocked)
+        d->scheduleBackendRead();
+}
+
+bool QSerialPortBackend::throttleRead(bool throttle)
+{
+    if (d->readBufferThrottling != QSerialPort::HardwareControl
+            || d->flowControl == QSerialPort::HardwareControl) {
+        return true;
+    }
+    return setRequestToSend(!throttle);
+}
+
+bool QSerialPortBackend::waitForDataRead(int msecs)
+{
+    if (!d->writeBuffer.isEmpty() && writeNotification() < 0)
+        return false;
+
+    if (!waitForReadyRead(QDeadlineTimer(msecs))) {
+        setError(QSerialPort::TimeoutError);
+        return false;
+    }
+
+    return readNotification();
+}
+
+bool QSerialPortBackend::waitForDataWritten(int msecs)
+{
+    if (d->writeBuffer.isEmpty())
+        return false;
+
+    const QDeadlineTimer deadline(msecs);
+    do {
+        const qint64 written = writeNotification();
+        if (written != 0)
+            return written > 0;
+    } while (waitForWritable(deadline));
+
+    setError(QSerialPort::TimeoutError);
+    return false;
+}
+
+QSerialPort::DriverQueueSizes QSerialPortBackend::driverQueueSizes()
+{
+    setError(QSerialPort::UnsupportedOperationError);
+    return {};
+}
+
+qint64 QSerialPortBackend::transmitQueueSize(std::optional<bool> *transmitterEmpty)
+{
+    Q_UNUSED(transmitterEmpty);
+    setError(QSerialPort::UnsupportedOperationError);
+    return -1;
+}
+
+bool QSerialPortBackend::setLineErrorReporting(bool enable)
+{
+    if (!enable)
+        return true;
+    setError(QSerialPort::UnsupportedOperationError,
+             QSerialPort::tr("Line error reporting is not supported"));
+    return false;
+}
+
+bool QSerialPortBackend::setNineBitMode(bool enable)
+{
+    if (!enable)
+        return true;
+    setError(QSerialPort::UnsupportedOperationError,
+             QSerialPort::tr("9-bit mode is not supported"));
+    return false;
+}
+
+qint64 QSerialPortBackend::writeNineBit(QByteArrayView data, bool ninthBit)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(ninthBit);
+    setError(QSerialPort::UnsupportedOperationError,
+             QSerialPort::tr("9-bit mode is not supported"));
+    return -1;
+}
+
+bool QSerialPortBackend::setRs485Configuration(const QSerialPortRs485Configuration &configuration)
+{
+    if (!configuration.isEnabled())
+        return true;
+    setError(QSerialPort::UnsupportedOperationError,
+             QSerialPort::tr("RS-485 mode is not supported"));
+    return false;
+}
+
+/*
+    Reads from the backend into the read buffer until it has no more data
+    or the buffer is full, and emits readyRead() for the new data.
+*/
+bool QSerialPortBackend::readNotification()
+{
+    qint64 newBytes = 0;
+    bool hasRead = false;
+    d->backendReadBlocked = false;
+    for (;;) {
+        qint64 bytesToRead = QSERIALPORT_BUFFERSIZE;
+        if (!d->isReadBufferBypassed() && d->readBufferMaxSize
+                && bytesToRead > (d->readBufferMaxSize - d->buffer.size())) {
+            bytesToRead = d->readBufferMaxSize - d->buffer.size();
+            if (bytesToRead <= 0) {
+                // Buffer is full. Continue once the user has read some data.
+                d->backendReadBlocked = true;
+                break;
+            }
+        }
+
+        char *ptr = d->reserveRead(bytesToRead);
+        const qint64 readBytes = read(ptr, bytesToRead);
+        newBytes += d->commitRead(ptr, bytesToRead, readBytes);
+        if (readBytes < 0) {
+            setError(QSerialPort::ReadError);
+            break;
+        }
+        hasRead = hasRead || readBytes > 0;
+        if (readBytes < bytesToRead)
+            break;
+    }
+
+    if (newBytes > 0) {
+        d->checkReadBufferWatermarks();
+        emit serialPort()->readyRead();
+    }
+    return hasRead;
+}
+
+/*
+    Writes the write buffer to the backend until it takes no more, and
+    emits bytesWritten() for the data taken. Returns the number of bytes
+    written, or -1 on error.
+*/
+qint64 QSerialPortBackend::writeNotification()
+{
+    qint64 written = 0;
+    while (!d->writeBuffer.isEmpty()) {
+        const qint64 chunk = write(d->writeBuffer.readPointer(),
+                                   d->writeBuffer.nextDataBlockSize());
+        if (chunk < 0) {
+            setError(QSerialPort::WriteError);
+            return -1;
+        }
+        if (chunk == 0)
+            break;
+        if (d->captureDevice) {
+            d->captureRecord(QSerialPortCapture::WriteRecord,
+                             d->writeBuffer.readPointer(), chunk);
+        }
+        d->writeBuffer.free(chunk);
+        written += chunk;
+    }
+
+    if (written > 0) {
+        d->checkWriteBufferDrained();
+        emit serialPort()->bytesWritten(written);
+    }
+    return written;
+}
+
+/*!
+    Makes \a factory create the backend for ports named
+    \c{scheme://location}. The factory is called with the location when
+    such a port is opened. A factory registered earlier for \a scheme is
+    replaced.
+
+    \note This function is thread-safe.
+
+    \sa unregisterBackend()
+*/
+void QSerialPortBackend::registerBackend(const QString &scheme, const Factory &factory)
+{
+    QMutexLocker locker(&backendRegistry->mutex);
+    backendRegistry->factories.insert(scheme, factory);
+}
+
+/*!
+    Removes the factory registered for \a scheme. Serial ports opened
+    afterwards with a name of that scheme use the serial port of the
+    platform.
+
+    \note This function is thread-safe.
+
+    \sa registerBackend()
+*/
+void QSerialPortBackend::unregisterBackend(const QString &scheme)
+{
+    QMutexLocker locker(&backendRegistry->mutex);
+    backendRegistry->factories.remove(scheme);
+}
+
+/*
+    Returns the backend for \a portName: the one registered for its
+    scheme, or the serial port of the platform.
+*/
+std::unique_ptr<QSerialPortBackend> QSerialPortBackend::create(const QString &portName)
+{
+    const qsizetype schemeEnd = portName.indexOf(QLatin1StringView("://"));
+    if (schemeEnd > 0) {
+        Factory factory;
+        {
+            QMutexLocker locker(&backendRegistry->mutex);
+            factory = backendRegistry->factories.value(portName.left(schemeEnd));
+        }
+        if (factory) {
+            if (std::unique_ptr<QSerialPortBackend> backend = factory(portName.mid(schemeEnd + 3)))
+                return backend;
+        }
+    }
+    return std::make_unique<QSerialPortNativeBackend>();
+}
+
+/*!
+    Returns the serial port that uses the backend, or \nullptr if it is
+    not in use.
+*/
+QSerialPort *QSerialPortBackend::serialPort() const
+{
+    return d ? d->q_func() : nullptr;
+}
+
+/*!
+    Tells the serial port that data can be read. The serial port calls
+    read() from the event loop.
+*/
+void QSerialPortBackend::readyRead()
+{
+    if (d)
+        d->scheduleBackendRead();
+}
+
+/*!
+    Tells the serial port that the backend can take more data. The serial
+    port calls write() from the event loop.
+*/
+void QSerialPortBackend::readyWrite()
+{
+    if (d)
+        d->scheduleBackendWrite();
+}
+
+/*!
+    Reports \a error with \a errorString on the serial port.
+*/
+void QSerialPortBackend::setError(QSerialPort::SerialPortError error, const QString &errorString)
+{
+    if (d)
+        d->setError(QSerialPortErrorInfo(error, errorString));
+}
+
+bool QSerialPortNativeBackend::open(QIODevice::OpenMode mode)
+{
+    return d->open(mode);
+}
+
+void QSerialPortNativeBackend::close()
+{
+    d->close();
+}
+
+qint64 QSerialPortNativeBackend::read(char *data, qint64 maxSize)
+{
+    // The native implementation reads into the read buffer by itself
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    Q_UNREACHABLE_RETURN(-1);
+}
+
+qint64 QSerialPortNativeBackend::write(const char *data, qint64 maxSize)
+{
+    // The native implementation writes from the write buffer by itself
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    Q_UNREACHABLE_RETURN(-1);
+}
+
+bool QSerialPortNativeBackend::setBaudRate(qint32 baudRate, QSerialPort::Directions directions)
+{
+    return d->setBaudRate(baudRate, directions);
+}
+
+bool QSerialPortNativeBackend::setDataBits(QSerialPort::DataBits dataBits)
+{
+    return d->setDataBits(dataBits);
+}
+
+bool QSerialPortNativeBackend::setParity(QSerialPort::Parity parity)
+{
+    return d->setParity(parity);
+}
+
+bool QSerialPortNativeBackend::setStopBits(QSerialPort::StopBits stopBits)
+{
+    return d->setStopBits(stopBits);
+}
+
+bool QSerialPortNativeBackend::setFlowControl(QSerialPort::FlowControl flowControl)
+{
+    return d->setFlowControl(flowControl);
+}
+
+QSerialPort::PinoutSignals QSerialPortNativeBackend::pinoutSignals()
+{
+    return d->pinoutSignals();
+}
+
+bool QSerialPortNativeBackend::setDataTerminalReady(bool set)
+{
+    return d->setDataTerminalReady(set);
+}
+
+bool QSerialPortNativeBackend::setRequestToSend(bool set)
+{
+    return d->setRequestToSend(set);
+}
+
+bool QSerialPortNativeBackend::setBreakEnabled(bool set)
+{
+    return d->setBreakEnabled(set);
+}
+
+bool QSerialPortNativeBackend::flush()
+{
+    return d->flush();
+}
+
+bool QSerialPortNativeBackend::clear(QSerialPort::Directions directions)
+{
+    return d->clear(directions);
+}
+
+bool QSerialPortNativeBackend::openDevice(QIODevice::OpenMode mode)
+{
+    return d->openDevice(mode);
+}
+
+bool QSerialPortNativeBackend::startDevice(QIODevice::OpenMode mode)
+{
+    return d->startNotifications(mode);
+}
+
+qint64 QSerialPortNativeBackend::queueWrite(const char *data, qint64 maxSize)
+{
+    return d->writeData(data, maxSize);
+}
+
+bool QSerialPortNativeBackend::flushWriteBuffer()
+{
+    return d->flush();
+}
+
+qint64 QSerialPortNativeBackend::readData(char *data, qint64 maxSize)
+{
+#if defined(Q_OS_UNIX)
+    if (d->blockingModeActive)
+        return d->readBlocking(data, maxSize);
+#endif
+    return QSerialPortBackend::readData(data, maxSize);
+}
+
+void QSerialPortNativeBackend::resumeRead()
+{
+    // Starts the notifications if they were disabled by the read handler;
+    // if they are enabled, this does nothing
+    d->startAsyncRead();
+}
+
+bool QSerialPortNativeBackend::throttleRead(bool throttle)
+{
+    return d->throttleRead(throttle);
+}
+
+bool QSerialPortNativeBackend::waitForDataRead(int msecs)
+{
+    return d->waitForReadyRead(msecs);
+}
+
+bool QSerialPortNativeBackend::waitForDataWritten(int msecs)
+{
+    return d->waitForBytesWritten(msecs);
+}
+
+QSerialPort::DriverQueueSizes QSerialPortNativeBackend::driverQueueSizes()
+{
+    return d->driverQueueSizes();
+}
+
+qint64 QSerialPortNativeBackend::transmitQueueSize(std::optional<bool> *transmitterEmpty)
+{
+    return d->transmitQueueSize(transmitterEmpty);
+}
+
+bool QSerialPortNativeBackend::setLineErrorReporting(bool enable)
+{
+    return d->setLineErrorReporting(enable);
+}
+
+bool QSerialPortNativeBackend::setNineBitMode(bool enable)
+{
+    return d->setNineBitMode(enable);
+}
+
+qint64 QSerialPortNativeBackend::writeNineBit(QByteArrayView data, bool ninthBit)
+{
+    return d->writeNineBit(data, ninthBit);
+}
+
+bool QSerialPortNativeBackend::setRs485Configuration(const QSerialPortRs485Configuration &configuration)
+{
+    return d->setRs485Configuration(configuration);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,93 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTBACKEND_H
+#define QSERIALPORTBACKEND_H
+
+#include <QtSerialPort/qserialport.h>
+
+#include <QtCore/qdeadlinetimer.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+class QSerialPortPrivate;
+
+class Q_SERIALPORT_EXPORT QSerialPortBackend
+{
+public:
+    using Factory = std::function<std::unique_ptr<QSerialPortBackend>(const QString &location)>;
+
+    QSerialPortBackend();
+    virtual ~QSerialPortBackend();
+
+    virtual bool open(QIODevice::OpenMode mode) = 0;
+    virtual void close() = 0;
+
+    virtual qint64 read(char *data, qint64 maxSize) = 0;
+    virtual qint64 write(const char *data, qint64 maxSize) = 0;
+
+    virtual bool waitForReadyRead(QDeadlineTimer deadline);
+    virtual bool waitForWritable(QDeadlineTimer deadline);
+
+    virtual bool setBaudRate(qint32 baudRate, QSerialPort::Directions directions);
+    virtual bool setDataBits(QSerialPort::DataBits dataBits);
+    virtual bool setParity(QSerialPort::Parity parity);
+    virtual bool setStopBits(QSerialPort::StopBits stopBits);
+    virtual bool setFlowControl(QSerialPort::FlowControl flowControl);
+
+    virtual QSerialPort::PinoutSignals pinoutSignals();
+    virtual bool setDataTerminalReady(bool set);
+    virtual bool setRequestToSend(bool set);
+    virtual bool setBreakEnabled(bool set);
+
+    virtual bool flush();
+    virtual bool clear(QSerialPort::Directions directions);
+
+    static void registerBackend(const QString &scheme, const Factory &factory);
+    static void unregisterBackend(const QString &scheme);
+
+protected:
+    QSerialPort *serialPort() const;
+    void readyRead();
+    void readyWrite();
+    void setError(QSerialPort::SerialPortError error, const QString &errorString = QString());
+
+private:
+    Q_DISABLE_COPY_MOVE(QSerialPortBackend)
+    friend class QSerialPortPrivate;
+    friend class QSerialPortNativeBackend;
+
+    // Called by QSerialPort. The default implementations move the data
+    // with read() and write(); the native serial port has its own.
+    virtual bool openDevice(QIODevice::OpenMode mode);
+    virtual bool startDevice(QIODevice::OpenMode mode);
+    virtual qint64 queueWrite(const char *data, qint64 maxSize);
+    virtual bool flushWriteBuffer();
+    virtual qint64 readData(char *data, qint64 maxSize);
+    virtual void resumeRead();
+    virtual bool throttleRead(bool throttle);
+    virtual bool waitForDataRead(int msecs);
+    virtual bool waitForDataWritten(int msecs);
+
+    virtual QSerialPort::DriverQueueSizes driverQueueSizes();
+    virtual qint64 transmitQueueSize(std::optional<bool> *transmitterEmpty);
+    virtual bool setLineErrorReporting(bool enable);
+    virtual bool setNineBitMode(bool enable);
+    virtual qint64 writeNineBit(QByteArrayView data, bool ninthBit);
+    virtual bool setRs485Configuration(const QSerialPortRs485Configuration &configuration);
+
+    bool readNotification();
+    qint64 writeNotification();
+
+    static std::unique_ptr<QSerialPortBackend> create(const QString &portName);
+
+    QSerialPortPrivate *d = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTBACKEND_H
@@ -0,0 +1,70 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTBACKEND_P_H
+#define QSERIALPORTBACKEND_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialportbackend.h"
+
+QT_BEGIN_NAMESPACE
+
+// The serial port of the platform, the default backend for port names
+// without a registered scheme. It forwards to the termios or Win32
+// implementation in QSerialPortPrivate, which reads into and writes from
+// the buffers of QSerialPort itself.
+class QSerialPortNativeBackend final : public QSerialPortBackend
+{
+public:
+    bool open(QIODevice::OpenMode mode) override;
+    void close() override;
+
+    qint64 read(char *data, qint64 maxSize) override;
+    qint64 write(const char *data, qint64 maxSize) override;
+
+    bool setBaudRate(qint32 baudRate, QSerialPort::Directions directions) override;
+    bool setDataBits(QSerialPort::DataBits dataBits) override;
+    bool setParity(QSerialPort::Parity parity) override;
+    bool setStopBits(QSerialPort::StopBits stopBits) override;
+    bool setFlowControl(QSerialPort::FlowControl flowControl) override;
+
+    QSerialPort::PinoutSignals pinoutSignals() override;
+    bool setDataTerminalReady(bool set) override;
+    bool setRequestToSend(bool set) override;
+    bool setBreakEnabled(bool set) override;
+
+    bool flush() override;
+    bool clear(QSerialPort::Directions directions) override;
+
+private:
+    bool openDevice(QIODevice::OpenMode mode) override;
+    bool startDevice(QIODevice::OpenMode mode) override;
+    qint64 queueWrite(const char *data, qint64 maxSize) override;
+    bool flushWriteBuffer() override;
+    qint64 readData(char *data, qint64 maxSize) override;
+    void resumeRead() override;
+    bool throttleRead(bool throttle) override;
+    bool waitForDataRead(int msecs) override;
+    bool waitForDataWritten(int msecs) override;
+
+    QSerialPort::DriverQueueSizes driverQueueSizes() override;
+    qint64 transmitQueueSize(std::optional<bool> *transmitterEmpty) override;
+    bool setLineErrorReporting(bool enable) override;
+    bool setNineBitMode(bool enable) override;
+    qint64 writeNineBit(QByteArrayView data, bool ninthBit) override;
+    bool setRs485Configuration(const QSerialPortRs485Configuration &configuration) override;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTBACKEND_P_H
@@ -0,0 +1,957 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportbroker_p.h"
+#include "qserialport.h"
+
+#include <QtCore/qdir.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/qstandardpaths.h>
+
+#include <private/qcore_unix_p.h>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+enum { BrokerReadChunkSize = 16384 };
+
+static QString brokerSocketPath(const QString &name)
+{
+    if (name.startsWith(u'/'))
+        return name;
+    // Unlike the shared temporary directory, only the user can access it
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (directory.isEmpty())
+        directory = QDir::tempPath();
+    return directory + u'/' + name;
+}
+
+static bool brokerSocketAddress(const QString &path, sockaddr_un *address)
+{
+    const QByteArray encodedPath = QFile::encodeName(path);
+    if (encodedPath.size() >= qsizetype(sizeof(address->sun_path)))
+        return false;
+
+    ::memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    ::memcpy(address->sun_path, encodedPath.constData(), encodedPath.size());
+    return true;
+}
+
+static int brokerSocket()
+{
+    const int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor == -1)
+        return -1;
+
+    ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    ::setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    return descriptor;
+}
+
+static void brokerSetNonBlocking(int descriptor)
+{
+    ::fcntl(descriptor, F_SETFL, ::fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+}
+
+static qint64 brokerSend(int descriptor, const char *data, qint64 size)
+{
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags |= MSG_NOSIGNAL;
+#endif
+    qint64 sent;
+    do {
+        sent = ::send(descriptor, data, size_t(size), flags);
+    } while (sent == -1 && errno == EINTR);
+    return sent;
+}
+
+/*!
+    \class QSerialPortBroker
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief Shares one open serial port with any number of local readers.
+
+    A serial port can only be opened by one process at a time. QSerialPortBroker
+    takes a QSerialPort that is already open and publishes it under a name on
+    a local (Unix domain) socket. Other processes, or other parts of the same
+    process, connect to it with QSerialPortBrokerClient.
+
+    All data received from the serial port is sent to every connected client.
+    The data is only read once from the port, and is shared between the
+    clients without being copied. A client that does not keep up is
+    disconnected once more than maxPendingClientData() bytes are queued for it.
+
+    Writes of the clients are arbitrated by the broker: every write() of a
+    client is forwarded to the serial port as a whole, so that writes of
+    different clients are never interleaved. If the write buffer of the
+    port is bounded, see QSerialPort::setWriteBufferMaxSize(), a request
+    that does not fit waits, and the broker stops reading from its client,
+    until the port has written some data. A client whose request is still
+    written only partly, for example because of a write error, is
+    disconnected.
+
+    \note This class is only available on Unix platforms.
+
+    \sa QSerialPortBrokerClient
+*/
+
+/*!
+    \fn void QSerialPortBroker::clientConnected()
+
+    This signal is emitted when a client has connected to the broker.
+*/
+
+/*!
+    \fn void QSerialPortBroker::clientDisconnected()
+
+    This signal is emitted when a client has disconnected from the broker, or
+    has been disconnected because it did not keep up with the data.
+*/
+
+/*!
+    Constructs a new broker object with the given \a parent.
+*/
+QSerialPortBroker::QSerialPortBroker(QObject *parent)
+    : QObject(*new QSerialPortBrokerPrivate, parent)
+{
+}
+
+/*!
+    Stops listening and disconnects all clients. The serial port is not
+    closed.
+*/
+QSerialPortBroker::~QSerialPortBroker()
+{
+    close();
+}
+
+/*!
+    Starts sharing the open \a port under \a name.
+
+    If \a name is not an absolute path, the socket is created in the runtime
+    directory of the user, see QStandardPaths::RuntimeLocation. The socket
+    file can only be accessed by its owner. A socket file left behind by a
+    broker that was not shut down cleanly is removed.
+
+    Returns \c true on success; otherwise returns \c false and sets
+    errorString().
+
+    \sa close(), fullServerName()
+*/
+bool QSerialPortBroker::listen(QSerialPort *port, const QString &name)
+{
+    Q_D(QSerialPortBroker);
+
+    if (d->listenDescriptor != -1) {
+        d->errorString = tr("The broker is already listening");
+        return false;
+    }
+    if (!port || !port->isOpen()) {
+        d->errorString = tr("The serial port is not open");
+        return false;
+    }
+    if (name.isEmpty()) {
+        d->errorString = tr("The server name is empty");
+        return false;
+    }
+
+    const QString path = brokerSocketPath(name);
+    sockaddr_un address;
+    if (!brokerSocketAddress(path, &address)) {
+        d->errorString = tr("The server name is too long");
+        return false;
+    }
+
+    const int descriptor = brokerSocket();
+    if (descriptor == -1) {
+        d->errorString = qt_error_string(errno);
+        return false;
+    }
+
+    int result = ::bind(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    if (result == -1 && errno == EADDRINUSE) {
+        // Only take over the name if nobody is accepting connections on it
+        const int probe = brokerSocket();
+        bool stale = false;
+        if (probe != -1) {
+            stale = ::connect(probe, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1
+                    && errno == ECONNREFUSED;
+            qt_safe_close(probe);
+        }
+        if (stale) {
+            ::unlink(address.sun_path);
+            result = ::bind(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        } else {
+            errno = EADDRINUSE;
+        }
+    }
+    // The mode of the file depends on the umask, restrict it before accepting
+    if (result != -1)
+        result = ::chmod(address.sun_path, S_IRUSR | S_IWUSR);
+    if (result == -1 || ::listen(descriptor, SOMAXCONN) == -1) {
+        d->errorString = qt_error_string(errno);
+        qt_safe_close(descriptor);
+        return false;
+    }
+    brokerSetNonBlocking(descriptor);
+
+    d->port = port;
+    d->serverName = name;
+    d->fullServerName = path;
+    d->errorString.clear();
+    d->listenDescriptor = descriptor;
+    d->listenNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Read, this);
+    connect(d->listenNotifier, &QSocketNotifier::activated, this, [d]() {
+        d->acceptConnections();
+    });
+    connect(port, &QIODevice::readyRead, this, [d]() {
+        d->readFromPort();
+    });
+    connect(port, &QIODevice::bytesWritten, this, [d]() {
+        d->resumeWaitingClients();
+    });
+    connect(port, &QIODevice::aboutToClose, this, &QSerialPortBroker::close);
+    connect(port, &QObject::destroyed, this, &QSerialPortBroker::close);
+
+    // Do not keep data that arrived before listening in the port buffer
+    d->readFromPort();
+    return true;
+}
+
+/*!
+    Stops listening, disconnects all clients and removes the socket file.
+    The serial port is not closed.
+
+    \sa listen()
+*/
+void QSerialPortBroker::close()
+{
+    Q_D(QSerialPortBroker);
+
+    if (d->listenDescriptor == -1)
+        return;
+
+    while (!d->clients.empty())
+        d->removeClient(d->clients.back().get());
+
+    delete d->listenNotifier;
+    d->listenNotifier = nullptr;
+    qt_safe_close(d->listenDescriptor);
+    d->listenDescriptor = -1;
+    ::unlink(QFile::encodeName(d->fullServerName).constData());
+
+    if (d->port)
+        disconnect(d->port, nullptr, this, nullptr);
+    d->port = nullptr;
+}
+
+/*!
+    Returns \c true if the broker is sharing a serial port; otherwise
+    returns \c false.
+*/
+bool QSerialPortBroker::isListening() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->listenDescriptor != -1;
+}
+
+/*!
+    Returns the shared serial port, or \c nullptr if the broker is not
+    listening.
+*/
+QSerialPort *QSerialPortBroker::serialPort() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->port;
+}
+
+/*!
+    Returns the name passed to listen().
+
+    \sa fullServerName()
+*/
+QString QSerialPortBroker::serverName() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->serverName;
+}
+
+/*!
+    Returns the path of the socket the broker listens on.
+
+    \sa serverName()
+*/
+QString QSerialPortBroker::fullServerName() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->fullServerName;
+}
+
+/*!
+    Returns the number of connected clients.
+*/
+int QSerialPortBroker::clientCount() const
+{
+    Q_D(const QSerialPortBroker);
+    return int(d->clients.size());
+}
+
+/*!
+    Returns the maximum number of bytes that are queued for a single client
+    before it is disconnected. The default is 1 MiB.
+*/
+qint64 QSerialPortBroker::maxPendingClientData() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->maxPendingClientData;
+}
+
+/*!
+    Sets the maximum number of bytes that are queued for a single client to
+    \a size. A size of \c 0 means that the queue is unlimited.
+*/
+void QSerialPortBroker::setMaxPendingClientData(qint64 size)
+{
+    Q_D(QSerialPortBroker);
+    d->maxPendingClientData = qMax(size, qint64(0));
+}
+
+/*!
+    Returns a human-readable description of the last error that occurred.
+*/
+QString QSerialPortBroker::errorString() const
+{
+    Q_D(const QSerialPortBroker);
+    return d->errorString;
+}
+
+void QSerialPortBrokerPrivate::acceptConnections()
+{
+    Q_Q(QSerialPortBroker);
+
+    for (;;) {
+        int descriptor;
+        do {
+            descriptor = ::accept(listenDescriptor, nullptr, nullptr);
+        } while (descriptor == -1 && errno == EINTR);
+        if (descriptor == -1)
+            return;
+
+        ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+        brokerSetNonBlocking(descriptor);
+
+        auto client = std::make_unique<Client>();
+        Client *c = client.get();
+        c->descriptor = descriptor;
+        c->readNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Read, q);
+        QObject::connect(c->readNotifier, &QSocketNotifier::activated, q, [this, c]() {
+            readFromClient(c);
+        });
+        c->writeNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Write, q);
+        c->writeNotifier->setEnabled(false);
+        QObject::connect(c->writeNotifier, &QSocketNotifier::activated, q, [this, c]() {
+            writeToClient(c);
+        });
+        clients.push_back(std::move(client));
+
+        emit q->clientConnected();
+    }
+}
+
+void QSerialPortBrokerPrivate::readFromPort()
+{
+    if (!port || !port->isReadable())
+        return;
+
+    for (QByteArray chunk = port->readChunk(); !chunk.isEmpty(); chunk = port->readChunk()) {
+        // Iterate backwards, writeToClient() may remove the client
+        for (qsizetype i = qsizetype(clients.size()) - 1; i >= 0; --i) {
+            Client *client = clients[i].get();
+            if (maxPendingClientData > 0
+                    && client->outbound.size() + chunk.size() > maxPendingClientData) {
+                removeClient(client);
+                continue;
+            }
+            const bool sending = !client->outbound.isEmpty();
+            client->outbound.append(chunk);
+            if (!sending)
+                writeToClient(client);
+        }
+    }
+}
+
+void QSerialPortBrokerPrivate::readFromClient(Client *client)
+{
+    const qsizetype size = client->inbound.size();
+    client->inbound.resize(size + BrokerReadChunkSize);
+    const qint64 readBytes = qt_safe_read(client->descriptor, client->inbound.data() + size,
+                                          BrokerReadChunkSize);
+    if (readBytes <= 0) {
+        client->inbound.resize(size);
+        if (readBytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            removeClient(client);
+        return;
+    }
+    client->inbound.resize(size + readBytes);
+    forwardRequests(client);
+}
+
+/*
+    Forwards every complete request of the client to the port in one piece.
+    A request that does not fit into the bounded write buffer of the port
+    stays, and the client is not read, until the port wrote some data.
+*/
+void QSerialPortBrokerPrivate::forwardRequests(Client *client)
+{
+    qsizetype position = 0;
+    while (client->inbound.size() - position >= QSerialPortBrokerHeaderSize) {
+        const quint32 requestSize =
+                qFromLittleEndian<quint32>(client->inbound.constData() + position);
+        if (requestSize > QSerialPortBrokerMaxRequestSize) {
+            removeClient(client);
+            return;
+        }
+        if (client->inbound.size() - position - QSerialPortBrokerHeaderSize < requestSize)
+            break;
+        if (port && port->isWritable()) {
+            if (!hasWriteRoom(requestSize)) {
+                client->waitingForPort = true;
+                client->readNotifier->setEnabled(false);
+                break;
+            }
+            // Writing may wait for the port and process its data, which can
+            // remove the client; it is only freed later
+            const qint64 written = port->write(
+                    client->inbound.constData() + position + QSerialPortBrokerHeaderSize,
+                    requestSize);
+            if (client->descriptor == -1)
+                return;
+            if (written != qint64(requestSize)) {
+                errorString = QSerialPortBroker::tr("A request of a client could not be "
+                                                    "written to the serial port whole");
+                removeClient(client);
+                return;
+            }
+        }
+        position += QSerialPortBrokerHeaderSize + requestSize;
+    }
+    client->inbound.remove(0, position);
+}
+
+// Whether the port takes a request of size bytes without splitting it
+bool QSerialPortBrokerPrivate::hasWriteRoom(qint64 size) const
+{
+    const qint64 maxSize = port->writeBufferMaxSize();
+    if (maxSize <= 0 || port->writeBufferPolicy() == QSerialPort::BlockWhenFull)
+        return true;
+    const qint64 queued = port->bytesToWrite();
+    return queued == 0 || queued + size <= maxSize;
+}
+
+void QSerialPortBrokerPrivate::resumeWaitingClients()
+{
+    // Iterate backwards, forwardRequests() may remove the client
+    for (qsizetype i = qsizetype(clients.size()) - 1; i >= 0; --i) {
+        if (i >= qsizetype(clients.size()))
+            continue;
+        Client *client = clients[i].get();
+        if (!client->waitingForPort)
+            continue;
+        client->waitingForPort = false;
+        client->readNotifier->setEnabled(true);
+        forwardRequests(client);
+    }
+}
+
+bool QSerialPortBrokerPrivate::writeToClient(Client *client)
+{
+    while (!client->outbound.isEmpty()) {
+        const qint64 sent = brokerSend(client->descriptor, client->outbound.readPointer(),
+                                       client->outbound.nextDataBlockSize());
+        if (sent == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            removeClient(client);
+            return false;
+        }
+        client->outbound.free(sent);
+    }
+
+    client->writeNotifier->setEnabled(!client->outbound.isEmpty());
+    return true;
+}
+
+void QSerialPortBrokerPrivate::removeClient(Client *client)
+{
+    Q_Q(QSerialPortBroker);
+
+    const auto it = std::find_if(clients.begin(), clients.end(),
+                                 [client](const auto &c) { return c.get() == client; });
+    if (it == clients.end())
+        return;
+
+    // The notifiers may be the ones currently delivering an event
+    client->readNotifier->setEnabled(false);
+    client->readNotifier->deleteLater();
+    client->writeNotifier->setEnabled(false);
+    client->writeNotifier->deleteLater();
+    qt_safe_close(client->descriptor);
+    client->descriptor = -1;
+
+    if (removedClients.empty()) {
+        QMetaObject::invokeMethod(q, [this]() { removedClients.clear(); },
+                                  Qt::QueuedConnection);
+    }
+    removedClients.push_back(std::move(*it));
+    clients.erase(it);
+
+    emit q->clientDisconnected();
+}
+
+/*!
+    \class QSerialPortBrokerClient
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief Provides access to a serial port shared by a QSerialPortBroker.
+
+    QSerialPortBrokerClient is a sequential QIODevice that connects to a
+    QSerialPortBroker when it is opened. It receives all data the broker reads
+    from the serial port, and its writes are forwarded to the serial port.
+    Each call to write() reaches the serial port as a whole, without being
+    interleaved with the writes of other clients. A single write() can pass
+    at most 1 MiB; larger writes fail.
+
+    The serial port settings are owned by the process running the broker.
+
+    \note This class is only available on Unix platforms.
+
+    \sa QSerialPortBroker
+*/
+
+/*!
+    \fn void QSerialPortBrokerClient::disconnected()
+
+    This signal is emitted when the connection to the broker is closed, either
+    by close() or because the broker went away. Data received before the
+    connection was lost can still be read.
+*/
+
+QSerialPortBrokerClientPrivate::QSerialPortBrokerClientPrivate()
+{
+    writeBufferChunkSize = BrokerReadChunkSize;
+    readBufferChunkSize = BrokerReadChunkSize;
+}
+
+/*!
+    Constructs a new client object with the given \a parent.
+*/
+QSerialPortBrokerClient::QSerialPortBrokerClient(QObject *parent)
+    : QIODevice(*new QSerialPortBrokerClientPrivate, parent)
+{
+}
+
+/*!
+    Constructs a new client object with the given \a parent, that connects
+    to the broker listening on \a name.
+*/
+QSerialPortBrokerClient::QSerialPortBrokerClient(const QString &name, QObject *parent)
+    : QIODevice(*new QSerialPortBrokerClientPrivate, parent)
+{
+    setServerName(name);
+}
+
+/*!
+    Closes the connection to the broker, if necessary, and then destroys
+    the object.
+*/
+QSerialPortBrokerClient::~QSerialPortBrokerClient()
+{
+    close();
+}
+
+/*!
+    Sets the \a name of the broker to connect to. The name is interpreted
+    the same way as by QSerialPortBroker::listen().
+
+    \sa serverName()
+*/
+void QSerialPortBrokerClient::setServerName(const QString &name)
+{
+    Q_D(QSerialPortBrokerClient);
+    d->serverName = name;
+}
+
+/*!
+    Returns the name of the broker to connect to.
+
+    \sa setServerName()
+*/
+QString QSerialPortBrokerClient::serverName() const
+{
+    Q_D(const QSerialPortBrokerClient);
+    return d->serverName;
+}
+
+/*!
+    \reimp
+
+    Connects to the broker and opens the device using \a mode. Returns
+    \c true if successful; otherwise returns \c false and sets an error
+    string.
+
+    \note The \l{QIODeviceBase::}{Append}, \l{QIODeviceBase::}{Truncate},
+    \l{QIODeviceBase::}{Text} and \l{QIODeviceBase::}{Unbuffered} modes are
+    not supported.
+*/
+bool QSerialPortBrokerClient::open(OpenMode mode)
+{
+    Q_D(QSerialPortBrokerClient);
+
+    if (isOpen()) {
+        setErrorString(tr("The device is already open"));
+        return false;
+    }
+
+    static const OpenMode unsupportedModes = Append | Truncate | Text | Unbuffered;
+    if ((mode & unsupportedModes) || mode == NotOpen) {
+        setErrorString(tr("Unsupported open mode"));
+        return false;
+    }
+
+    sockaddr_un address;
+    if (!brokerSocketAddress(brokerSocketPath(d->serverName), &address)) {
+        setErrorString(tr("The server name is too long"));
+        return false;
+    }
+
+    const int descriptor = brokerSocket();
+    if (descriptor == -1) {
+        d->setErrorFromSystem(errno);
+        return false;
+    }
+
+    int result;
+    do {
+        result = ::connect(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    } while (result == -1 && errno == EINTR);
+    if (result == -1) {
+        d->setErrorFromSystem(errno);
+        qt_safe_close(descriptor);
+        return false;
+    }
+    brokerSetNonBlocking(descriptor);
+
+    d->descriptor = descriptor;
+    d->readNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Read, this);
+    connect(d->readNotifier, &QSocketNotifier::activated, this, [d]() {
+        d->readNotification();
+    });
+    d->writeNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Write, this);
+    d->writeNotifier->setEnabled(false);
+    connect(d->writeNotifier, &QSocketNotifier::activated, this, [d]() {
+        d->writeNotification();
+    });
+
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+
+    Closes the connection to the broker. Data that has not been sent to the
+    broker yet is discarded; call waitForBytesWritten() first to send it.
+*/
+void QSerialPortBrokerClient::close()
+{
+    Q_D(QSerialPortBrokerClient);
+
+    if (!isOpen())
+        return;
+
+    if (d->descriptor != -1) {
+        d->writeNotification();
+        d->disconnectFromBroker();
+    }
+    d->pendingRequests.clear();
+    d->requestBytesSent = 0;
+    d->pendingPayload = 0;
+    QIODevice::close();
+}
+
+/*!
+    Returns \c true if the client is connected to the broker; otherwise
+    returns \c false.
+*/
+bool QSerialPortBrokerClient::isConnected() const
+{
+    Q_D(const QSerialPortBrokerClient);
+    return d->descriptor != -1;
+}
+
+/*!
+    \reimp
+
+    Always returns \c true. The client is a sequential device.
+*/
+bool QSerialPortBrokerClient::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+
+    Returns the number of bytes that are waiting to be sent to the broker.
+*/
+qint64 QSerialPortBrokerClient::bytesToWrite() const
+{
+    Q_D(const QSerialPortBrokerClient);
+    return d->pendingPayload;
+}
+
+/*!
+    \reimp
+
+    Waits until new data has been received from the broker, or \a msecs
+    milliseconds have passed. If \a msecs is -1, this function will not
+    time out. Returns \c true if new data is available for reading.
+*/
+bool QSerialPortBrokerClient::waitForReadyRead(int msecs)
+{
+    Q_D(QSerialPortBrokerClient);
+
+    const QDeadlineTimer deadline(msecs);
+    while (d->descriptor != -1) {
+        bool readyToRead = false;
+        bool readyToWrite = false;
+        if (!d->waitForReadOrWrite(&readyToRead, &readyToWrite, !d->writeBuffer.isEmpty(),
+                                   deadline)) {
+            return false;
+        }
+        if (readyToRead)
+            return d->readNotification();
+        if (readyToWrite && !d->writeNotification())
+            return false;
+    }
+    return false;
+}
+
+/*!
+    \reimp
+
+    Waits until data has been sent to the broker, or \a msecs milliseconds
+    have passed. If \a msecs is -1, this function will not time out.
+    Returns \c true if the bytesWritten() signal has been emitted.
+*/
+bool QSerialPortBrokerClient::waitForBytesWritten(int msecs)
+{
+    Q_D(QSerialPortBrokerClient);
+
+    const QDeadlineTimer deadline(msecs);
+    while (d->descriptor != -1 && !d->writeBuffer.isEmpty()) {
+        bool readyToRead = false;
+        bool readyToWrite = false;
+        if (!d->waitForReadOrWrite(&readyToRead, &readyToWrite, true, deadline))
+            return false;
+        if (readyToRead && !d->readNotification())
+            return false;
+        if (readyToWrite)
+            return d->writeNotification();
+    }
+    return false;
+}
+
+/*!
+    \reimp
+*/
+qint64 QSerialPortBrokerClient::readData(char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    // All data is read into the buffer of QIODevice by the notifier
+    return 0;
+}
+
+/*!
+    \reimp
+*/
+qint64 QSerialPortBrokerClient::writeData(const char *data, qint64 maxSize)
+{
+    Q_D(QSerialPortBrokerClient);
+
+    if (d->descriptor == -1) {
+        setErrorString(tr("Not connected to the broker"));
+        return -1;
+    }
+
+    // The broker forwards a request as a whole, splitting it would not
+    if (maxSize > QSerialPortBrokerMaxRequestSize) {
+        setErrorString(tr("The write exceeds the maximum request size of %1 bytes")
+                       .arg(int(QSerialPortBrokerMaxRequestSize)));
+        return -1;
+    }
+    if (maxSize == 0)
+        return 0;
+
+    const quint32 header = qToLittleEndian(quint32(maxSize));
+    d->writeBuffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    d->writeBuffer.append(data, maxSize);
+    d->pendingRequests.append(maxSize + QSerialPortBrokerHeaderSize);
+    d->pendingPayload += maxSize;
+
+    d->writeNotifier->setEnabled(true);
+    return maxSize;
+}
+
+bool QSerialPortBrokerClientPrivate::readNotification()
+{
+    Q_Q(QSerialPortBrokerClient);
+
+    char *ptr = buffer.reserve(BrokerReadChunkSize);
+    const qint64 readBytes = qt_safe_read(descriptor, ptr, BrokerReadChunkSize);
+    buffer.chop(BrokerReadChunkSize - qMax(readBytes, qint64(0)));
+
+    if (readBytes < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return false;
+        setErrorFromSystem(errno);
+        disconnectFromBroker();
+        return false;
+    }
+    if (readBytes == 0) {
+        disconnectFromBroker();
+        return false;
+    }
+
+    if (!q->isReadable()) {
+        buffer.clear();
+        return false;
+    }
+
+    if (!emittedReadyRead) {
+        emittedReadyRead = true;
+        emit q->readyRead();
+        emittedReadyRead = false;
+    }
+    return true;
+}
+
+bool QSerialPortBrokerClientPrivate::writeNotification()
+{
+    Q_Q(QSerialPortBrokerClient);
+
+    qint64 payloadSent = 0;
+    while (!writeBuffer.isEmpty()) {
+        qint64 sent = brokerSend(descriptor, writeBuffer.readPointer(),
+                                 writeBuffer.nextDataBlockSize());
+        if (sent == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            setErrorFromSystem(errno);
+            disconnectFromBroker();
+            return false;
+        }
+        writeBuffer.free(sent);
+
+        // Do not count the request headers as written data
+        while (sent > 0) {
+            const qint64 requestSize = pendingRequests.constFirst();
+            const qint64 chunk = qMin(sent, requestSize - requestBytesSent);
+            payloadSent += qMax(requestBytesSent + chunk - QSerialPortBrokerHeaderSize, qint64(0))
+                    - qMax(requestBytesSent - QSerialPortBrokerHeaderSize, qint64(0));
+            requestBytesSent += chunk;
+            sent -= chunk;
+            if (requestBytesSent == requestSize) {
+                pendingRequests.removeFirst();
+                requestBytesSent = 0;
+            }
+        }
+    }
+
+    if (writeNotifier)
+        writeNotifier->setEnabled(!writeBuffer.isEmpty());
+
+    if (payloadSent == 0)
+        return false;
+
+    pendingPayload -= payloadSent;
+    if (!emittedBytesWritten) {
+        emittedBytesWritten = true;
+        emit q->bytesWritten(payloadSent);
+        emittedBytesWritten = false;
+    }
+    return true;
+}
+
+bool QSerialPortBrokerClientPrivate::waitForReadOrWrite(bool *selectForRead, bool *selectForWrite,
+                                                        bool checkWrite, QDeadlineTimer deadline)
+{
+    Q_Q(QSerialPortBrokerClient);
+
+    pollfd pfd = qt_make_pollfd(descriptor, POLLIN);
+    if (checkWrite)
+        pfd.events |= POLLOUT;
+
+    const int ret = qt_safe_poll(&pfd, 1, deadline);
+    if (ret < 0) {
+        setErrorFromSystem(errno);
+        return false;
+    }
+    if (ret == 0) {
+        q->setErrorString(QSerialPortBrokerClient::tr("Operation timed out"));
+        return false;
+    }
+
+    *selectForRead = (pfd.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+    *selectForWrite = (pfd.revents & POLLOUT) != 0;
+    return true;
+}
+
+void QSerialPortBrokerClientPrivate::disconnectFromBroker()
+{
+    Q_Q(QSerialPortBrokerClient);
+
+    if (descriptor == -1)
+        return;
+
+    // The notifiers may be the ones currently delivering an event
+    readNotifier->setEnabled(false);
+    readNotifier->deleteLater();
+    readNotifier = nullptr;
+    writeNotifier->setEnabled(false);
+    writeNotifier->deleteLater();
+    writeNotifier = nullptr;
+    qt_safe_close(descriptor);
+    descriptor = -1;
+
+    emit q->readChannelFinished();
+    emit q->disconnected();
+}
+
+void QSerialPortBrokerClientPrivate::setErrorFromSystem(int errorCode)
+{
+    Q_Q(QSerialPortBrokerClient);
+    q->setErrorString(qt_error_string(errorCode));
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qserialportbroker.cpp"
@@ -0,0 +1,89 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTBROKER_H
+#define QSERIALPORTBROKER_H
+
+#include <QtCore/qiodevice.h>
+
+#include <QtSerialPort/qserialportglobal.h>
+
+#if defined(Q_OS_UNIX) || defined(Q_QDOC)
+
+QT_BEGIN_NAMESPACE
+
+class QSerialPort;
+class QSerialPortBrokerPrivate;
+class QSerialPortBrokerClientPrivate;
+
+class Q_SERIALPORT_EXPORT QSerialPortBroker : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QSerialPortBroker)
+
+public:
+    explicit QSerialPortBroker(QObject *parent = nullptr);
+    ~QSerialPortBroker() override;
+
+    bool listen(QSerialPort *port, const QString &name);
+    void close();
+    bool isListening() const;
+
+    QSerialPort *serialPort() const;
+    QString serverName() const;
+    QString fullServerName() const;
+    int clientCount() const;
+
+    qint64 maxPendingClientData() const;
+    void setMaxPendingClientData(qint64 size);
+
+    QString errorString() const;
+
+Q_SIGNALS:
+    void clientConnected();
+    void clientDisconnected();
+
+private:
+    Q_DISABLE_COPY(QSerialPortBroker)
+};
+
+class Q_SERIALPORT_EXPORT QSerialPortBrokerClient : public QIODevice
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QSerialPortBrokerClient)
+
+public:
+    explicit QSerialPortBrokerClient(QObject *parent = nullptr);
+    explicit QSerialPortBrokerClient(const QString &name, QObject *parent = nullptr);
+    ~QSerialPortBrokerClient() override;
+
+    void setServerName(const QString &name);
+    QString serverName() const;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isConnected() const;
+
+    bool isSequential() const override;
+    qint64 bytesToWrite() const override;
+
+    bool waitForReadyRead(int msecs = 30000) override;
+    bool waitForBytesWritten(int msecs = 30000) override;
+
+Q_SIGNALS:
+    void disconnected();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    Q_DISABLE_COPY(QSerialPortBrokerClient)
+};
+
+QT_END_NAMESPACE
+
+#endif // Q_OS_UNIX || Q_QDOC
+
+#endif // QSERIALPORTBROKER_H
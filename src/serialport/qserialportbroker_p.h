@@ -0,0 +1,108 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTBROKER_P_H
+#define QSERIALPORTBROKER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialportbroker.h"
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qpointer.h>
+
+#include <private/qiodevice_p.h>
+#include <private/qobject_p.h>
+#include <private/qringbuffer_p.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+// Every write of a client reaches the broker as one request: a 32-bit
+// little-endian payload size followed by the payload. Data from the port
+// is sent to the clients as a plain byte stream.
+enum { QSerialPortBrokerHeaderSize = 4 };
+enum { QSerialPortBrokerMaxRequestSize = 1024 * 1024 };
+
+class QSerialPortBrokerPrivate : public QObjectPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QSerialPortBroker)
+
+    struct Client
+    {
+        int descriptor = -1;
+        QSocketNotifier *readNotifier = nullptr;
+        QSocketNotifier *writeNotifier = nullptr;
+        QByteArray inbound;   // incomplete write request
+        QRingBuffer outbound; // port data not yet sent to the client
+        bool waitingForPort = false; // a request waits for room in the port
+    };
+
+    void acceptConnections();
+    void readFromPort();
+    void readFromClient(Client *client);
+    void forwardRequests(Client *client);
+    void resumeWaitingClients();
+    bool hasWriteRoom(qint64 size) const;
+    bool writeToClient(Client *client);
+    void removeClient(Client *client);
+
+    QPointer<QSerialPort> port;
+    QString serverName;
+    QString fullServerName;
+    QString errorString;
+    int listenDescriptor = -1;
+    QSocketNotifier *listenNotifier = nullptr;
+    std::vector<std::unique_ptr<Client>> clients;
+    // Removed clients are freed later, the port may remove one while a
+    // request of it is being written
+    std::vector<std::unique_ptr<Client>> removedClients;
+    qint64 maxPendingClientData = 1024 * 1024;
+};
+
+class QSerialPortBrokerClientPrivate : public QIODevicePrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QSerialPortBrokerClient)
+
+    QSerialPortBrokerClientPrivate();
+
+    bool readNotification();
+    bool writeNotification();
+    bool waitForReadOrWrite(bool *selectForRead, bool *selectForWrite,
+                            bool checkWrite, QDeadlineTimer deadline);
+    void disconnectFromBroker();
+    void setErrorFromSystem(int errorCode);
+
+    QString serverName;
+    int descriptor = -1;
+    QSocketNotifier *readNotifier = nullptr;
+    QSocketNotifier *writeNotifier = nullptr;
+
+    // Sizes of the requests in the write buffer, including their header,
+    // used to report written payload bytes only.
+    QList<qint64> pendingRequests;
+    qint64 requestBytesSent = 0;
+    qint64 pendingPayload = 0;
+
+    bool emittedReadyRead = false;
+    bool emittedBytesWritten = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTBROKER_P_H
@@ -0,0 +1,65 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTCAPTURE_P_H
+#define QSERIALPORTCAPTURE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+// Layout of the files written by QSerialPort::setCaptureDevice() and read
+// by QSerialPortReplay. All integers are little-endian.
+//
+// The file starts with an 8 byte header: the magic "QSPCAP" followed by
+// a 16-bit version. Each record then consists of a 16 byte header and its
+// payload, padded to a multiple of 8 bytes so that the record headers stay
+// aligned in a memory-mapped file:
+//
+//   quint8  type        RecordType
+//   quint8  reserved[3]
+//   quint32 size        payload size, without padding
+//   qint64  timestamp   monotonic nanoseconds since the capture started
+//
+// The payload of a SettingsRecord is:
+//
+//   qint32  inputBaudRate
+//   qint32  outputBaudRate
+//   quint8  dataBits, parity, stopBits, flowControl
+//   quint8  reserved[4]
+namespace QSerialPortCapture {
+
+enum RecordType : quint8 {
+    ReadRecord = 1,
+    WriteRecord = 2,
+    SettingsRecord = 3
+};
+
+constexpr char Magic[6] = { 'Q', 'S', 'P', 'C', 'A', 'P' };
+constexpr quint16 Version = 1;
+
+constexpr qint64 FileHeaderSize = 8;
+constexpr qint64 RecordHeaderSize = 16;
+constexpr qint64 SettingsSize = 16;
+
+constexpr qint64 recordSize(qint64 payloadSize)
+{
+    return RecordHeaderSize + ((payloadSize + 7) & ~qint64(7));
+}
+
+} // namespace QSerialPortCapture
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTCAPTURE_P_H
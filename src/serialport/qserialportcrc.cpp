@@ -0,0 +1,149 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportcrc_p.h"
+
+#include <QtCore/qendian.h>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+using CrcTables = std::array<std::array<quint32, 256>, 8>;
+
+// tables[k][b] is the contribution of byte b followed by k zero bytes, so
+// that eight bytes are folded into the register with eight lookups.
+constexpr CrcTables reflectedTables(quint32 polynomial)
+{
+    CrcTables tables = {};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+        tables[0][i] = crc;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (quint32 i = 0; i < 256; ++i)
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xff];
+    }
+    return tables;
+}
+
+constexpr CrcTables normalTables16(quint32 polynomial)
+{
+    CrcTables tables = {};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i << 8;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = ((crc & 0x8000) ? (crc << 1) ^ polynomial : crc << 1) & 0xffff;
+        tables[0][i] = crc;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (quint32 i = 0; i < 256; ++i) {
+            tables[k][i] = ((tables[k - 1][i] << 8) & 0xffff)
+                    ^ tables[0][(tables[k - 1][i] >> 8) & 0xff];
+        }
+    }
+    return tables;
+}
+
+// CRC-16/MODBUS: x^16 + x^15 + x^2 + 1, reflected
+constexpr CrcTables modbusTables = reflectedTables(0xa001);
+// CRC-16/IBM-3740, also known as CRC-16/CCITT-FALSE: x^16 + x^12 + x^5 + 1
+constexpr CrcTables ccittTables = normalTables16(0x1021);
+// CRC-32/ISO-HDLC, as used by Ethernet and zlib, reflected
+constexpr CrcTables crc32Tables = reflectedTables(0xedb88320);
+
+quint32 updateReflected(const CrcTables &t, quint32 crc, const uchar *p, qsizetype size)
+{
+    while (size >= 8) {
+        const quint32 low = qFromLittleEndian<quint32>(p) ^ crc;
+        const quint32 high = qFromLittleEndian<quint32>(p + 4);
+        crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff]
+                ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+                ^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff]
+                ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xff];
+    return crc;
+}
+
+quint32 updateNormal16(const CrcTables &t, quint32 crc, const uchar *p, qsizetype size)
+{
+    while (size >= 8) {
+        crc = t[7][p[0] ^ (crc >> 8)] ^ t[6][p[1] ^ (crc & 0xff)]
+                ^ t[5][p[2]] ^ t[4][p[3]] ^ t[3][p[4]]
+                ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+        crc = ((crc << 8) & 0xffff) ^ t[0][((crc >> 8) ^ *p++) & 0xff];
+    return crc;
+}
+
+} // namespace
+
+qsizetype QSerialPortCrc::size(QSerialPort::FrameCheck check)
+{
+    switch (check) {
+    case QSerialPort::Crc16ModbusCheck:
+    case QSerialPort::Crc16CcittCheck:
+        return 2;
+    case QSerialPort::Crc32Check:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+quint32 QSerialPortCrc::checksum(QSerialPort::FrameCheck check, QByteArrayView data)
+{
+    const auto p = reinterpret_cast<const uchar *>(data.data());
+    switch (check) {
+    case QSerialPort::Crc16ModbusCheck:
+        return updateReflected(modbusTables, 0xffff, p, data.size());
+    case QSerialPort::Crc16CcittCheck:
+        return updateNormal16(ccittTables, 0xffff, p, data.size());
+    case QSerialPort::Crc32Check:
+        return ~updateReflected(crc32Tables, 0xffffffff, p, data.size());
+    default:
+        return 0;
+    }
+}
+
+qsizetype QSerialPortCrc::store(QSerialPort::FrameCheck check, QByteArrayView data, char *out)
+{
+    const quint32 crc = checksum(check, data);
+    switch (check) {
+    case QSerialPort::Crc16ModbusCheck:
+        qToLittleEndian<quint16>(quint16(crc), out);
+        break;
+    case QSerialPort::Crc16CcittCheck:
+        qToBigEndian<quint16>(quint16(crc), out);
+        break;
+    case QSerialPort::Crc32Check:
+        qToLittleEndian<quint32>(crc, out);
+        break;
+    default:
+        break;
+    }
+    return size(check);
+}
+
+bool QSerialPortCrc::verify(QSerialPort::FrameCheck check, QByteArrayView data)
+{
+    const qsizetype checkSize = size(check);
+    if (data.size() < checkSize)
+        return false;
+    char expected[4];
+    store(check, data.first(data.size() - checkSize), expected);
+    return data.last(checkSize) == QByteArrayView(expected, checkSize);
+}
+
+QT_END_NAMESPACE
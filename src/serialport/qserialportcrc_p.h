@@ -0,0 +1,42 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTCRC_P_H
+#define QSERIALPORTCRC_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialport.h"
+
+QT_BEGIN_NAMESPACE
+
+// The check sequences of QSerialPort::FrameCheck, computed eight bytes at a
+// time with slice-by-8 tables.
+namespace QSerialPortCrc {
+
+// Size of the check sequence appended to a frame, in bytes
+qsizetype size(QSerialPort::FrameCheck check);
+
+quint32 checksum(QSerialPort::FrameCheck check, QByteArrayView data);
+
+// Writes the check sequence of data to out, in the byte order of the
+// algorithm, and returns its size
+qsizetype store(QSerialPort::FrameCheck check, QByteArrayView data, char *out);
+
+// Returns true if data ends with a valid check sequence of the data before it
+bool verify(QSerialPort::FrameCheck check, QByteArrayView data);
+
+} // namespace QSerialPortCrc
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTCRC_P_H
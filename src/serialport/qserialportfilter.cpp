@@ -0,0 +1,116 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportfilter.h"
+#include "qserialport_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSerialPortFilter
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief The QSerialPortFilter class is a stage in the chain of byte
+    transforms between a serial port and its read and write buffers.
+
+    Filters installed with QSerialPort::addFilter() see the data of the
+    serial port right after it is read from the driver and right before
+    it is handed over to the write buffer. Each filter receives a view on
+    the data and passes the result on to the next stage through an
+    Output, without any buffers in between:
+
+    \code
+    class Descrambler : public QSerialPortFilter
+    {
+    public:
+        void processInbound(QByteArrayView data, Output &output) override
+        {
+            scratch.resize(data.size());
+            for (qsizetype i = 0; i < data.size(); ++i)
+                scratch[i] = data[i] ^ key;
+            output.write(scratch);
+        }
+
+    private:
+        QByteArray scratch;
+        char key = 0x5a;
+    };
+    \endcode
+
+    A filter that leaves some of the data as it is passes views on the
+    input along, which costs no copy at all. A filter may call
+    Output::write() any number of times, or not at all, for example to
+    hold back an incomplete record until the next call, or to drop data.
+    The next stage processes the data before Output::write() returns, so
+    the views only have to stay valid for the duration of the call, and a
+    chunk read from the driver passes the whole chain while it is still in
+    the cache.
+
+    The received data ends up in the read buffer, or with the data handler
+    and the frame decoder if they are set. The written data ends up in the
+    write buffer, so bytesToWrite() and QIODevice::bytesWritten() count
+    the bytes after the filters.
+
+    Filters are called in the thread of the serial port. They must not add
+    or remove filters of the serial port while processing.
+
+    \sa QSerialPort::addFilter()
+*/
+
+/*!
+    \class QSerialPortFilter::Output
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief The Output class passes the data of a QSerialPortFilter on to
+    the next stage.
+*/
+
+/*!
+    Passes \a data on to the next stage of the chain, which processes it
+    before this function returns.
+*/
+void QSerialPortFilter::Output::write(QByteArrayView data)
+{
+    if (data.isEmpty())
+        return;
+    if (direction == Inbound)
+        d->filterInbound(stage + 1, data);
+    else
+        d->filterOutbound(stage + 1, data);
+}
+
+/*!
+    \fn QSerialPortFilter::QSerialPortFilter()
+
+    Constructs a filter that passes all data through unchanged.
+*/
+
+/*!
+    Destroys the filter. Remove the filter from the serial port before
+    destroying it.
+*/
+QSerialPortFilter::~QSerialPortFilter() = default;
+
+/*!
+    Processes \a data received by the serial port and passes the result on
+    with \a output. The default implementation passes \a data through
+    unchanged.
+*/
+void QSerialPortFilter::processInbound(QByteArrayView data, Output &output)
+{
+    output.write(data);
+}
+
+/*!
+    Processes \a data written to the serial port and passes the result on
+    with \a output. The default implementation passes \a data through
+    unchanged.
+*/
+void QSerialPortFilter::processOutbound(QByteArrayView data, Output &output)
+{
+    output.write(data);
+}
+
+QT_END_NAMESPACE
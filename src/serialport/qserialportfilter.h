@@ -0,0 +1,54 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTFILTER_H
+#define QSERIALPORTFILTER_H
+
+#include <QtCore/qbytearrayview.h>
+
+#include <QtSerialPort/qserialportglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSerialPortPrivate;
+
+class Q_SERIALPORT_EXPORT QSerialPortFilter
+{
+public:
+    class Q_SERIALPORT_EXPORT Output
+    {
+    public:
+        void write(QByteArrayView data);
+
+    private:
+        friend class QSerialPortPrivate;
+
+        enum Direction {
+            Inbound,
+            Outbound
+        };
+
+        Output(QSerialPortPrivate *d, Direction direction, qsizetype stage) noexcept
+            : d(d), direction(direction), stage(stage)
+        {
+        }
+        Q_DISABLE_COPY_MOVE(Output)
+
+        QSerialPortPrivate *d;
+        Direction direction;
+        qsizetype stage;
+    };
+
+    QSerialPortFilter() = default;
+    virtual ~QSerialPortFilter();
+
+    virtual void processInbound(QByteArrayView data, Output &output);
+    virtual void processOutbound(QByteArrayView data, Output &output);
+
+private:
+    Q_DISABLE_COPY_MOVE(QSerialPortFilter)
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTFILTER_H
@@ -0,0 +1,310 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportframing_p.h"
+#include "qserialportcrc_p.h"
+
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// The byte-stuffing framings delimit frames with a flag byte and escape the
+// flag and the escape byte inside a frame. A lookup table marks both, so that
+// runs of ordinary bytes are found with a single test per byte and copied in
+// one go.
+struct EscapeScheme
+{
+    quint8 flag;
+    quint8 escape;
+    std::array<bool, 256> special;
+
+    quint8 escaped(quint8 c) const;
+    quint8 unescaped(quint8 c) const;
+};
+
+constexpr std::array<bool, 256> specialBytes(quint8 flag, quint8 escape)
+{
+    std::array<bool, 256> table = {};
+    table[flag] = true;
+    table[escape] = true;
+    return table;
+}
+
+// RFC 1055
+enum : quint8 {
+    SlipEnd = 0xc0,
+    SlipEsc = 0xdb,
+    SlipEscEnd = 0xdc,
+    SlipEscEsc = 0xdd
+};
+
+// Asynchronous HDLC framing as in RFC 1662, without the frame check sequence
+enum : quint8 {
+    HdlcFlag = 0x7e,
+    HdlcEscape = 0x7d,
+    HdlcXor = 0x20
+};
+
+constexpr EscapeScheme slipScheme = { SlipEnd, SlipEsc, specialBytes(SlipEnd, SlipEsc) };
+constexpr EscapeScheme hdlcScheme = { HdlcFlag, HdlcEscape, specialBytes(HdlcFlag, HdlcEscape) };
+
+quint8 EscapeScheme::escaped(quint8 c) const
+{
+    if (flag == SlipEnd)
+        return c == SlipEnd ? SlipEscEnd : SlipEscEsc;
+    return c ^ HdlcXor;
+}
+
+quint8 EscapeScheme::unescaped(quint8 c) const
+{
+    if (flag == SlipEnd) {
+        // RFC 1055 leaves other bytes after an escape as they are
+        if (c == SlipEscEnd)
+            return SlipEnd;
+        if (c == SlipEscEsc)
+            return SlipEsc;
+        return c;
+    }
+    return c ^ HdlcXor;
+}
+
+const EscapeScheme &escapeScheme(QSerialPort::Framing framing)
+{
+    return framing == QSerialPort::SlipFraming ? slipScheme : hdlcScheme;
+}
+
+// The frame is encoded in parts, the payload followed by the check sequence
+qint64 encodeEscaped(const EscapeScheme &scheme, std::initializer_list<QByteArrayView> parts,
+                     char *out)
+{
+    char *dst = out;
+    *dst++ = char(scheme.flag);
+
+    for (QByteArrayView part : parts) {
+        const char *p = part.data();
+        const char *const end = p + part.size();
+        while (p < end) {
+            const char *run = p;
+            while (p < end && !scheme.special[quint8(*p)])
+                ++p;
+            ::memcpy(dst, run, p - run);
+            dst += p - run;
+            if (p == end)
+                break;
+            *dst++ = char(scheme.escape);
+            *dst++ = char(scheme.escaped(quint8(*p++)));
+        }
+    }
+
+    *dst++ = char(scheme.flag);
+    return dst - out;
+}
+
+// Consistent Overhead Byte Stuffing, terminated by a zero byte
+qint64 encodeCobs(std::initializer_list<QByteArrayView> parts, char *out)
+{
+    char *code = out;
+    char *dst = out + 1;
+    quint8 length = 1;
+
+    for (QByteArrayView part : parts) {
+        const char *p = part.data();
+        const char *const end = p + part.size();
+        while (p < end) {
+            const void *zero = ::memchr(p, 0, qMin<qint64>(end - p, 0xff - length));
+            const char *runEnd = zero ? static_cast<const char *>(zero)
+                                      : p + qMin<qint64>(end - p, 0xff - length);
+            ::memcpy(dst, p, runEnd - p);
+            dst += runEnd - p;
+            length += quint8(runEnd - p);
+            p = runEnd;
+
+            if (zero || length == 0xff) {
+                if (zero)
+                    ++p;
+                *code = char(length);
+                code = dst++;
+                length = 1;
+            }
+        }
+    }
+
+    *code = char(length);
+    *dst++ = 0;
+    return dst - out;
+}
+
+} // namespace
+
+void QSerialPortFrameCodec::reset(QSerialPort::Framing framing)
+{
+    framingMode = framing;
+    frame.clear();
+    escaped = false;
+    oversized = false;
+    cobsRemaining = 0;
+    cobsZeroPending = false;
+}
+
+void QSerialPortFrameCodec::setFrameCheck(QSerialPort::FrameCheck frameCheck)
+{
+    check = frameCheck;
+    checkErrors = 0;
+    dropFrame();
+}
+
+qint64 QSerialPortFrameCodec::maximumEncodedSize(qint64 size) const
+{
+    size += QSerialPortCrc::size(check);
+    switch (framingMode) {
+    case QSerialPort::SlipFraming:
+    case QSerialPort::HdlcFraming:
+        return 2 + 2 * size;
+    case QSerialPort::CobsFraming:
+        return size + size / 254 + 2;
+    default:
+        return size;
+    }
+}
+
+qint64 QSerialPortFrameCodec::encode(QByteArrayView frame, char *out) const
+{
+    char checkSequence[4];
+    const QByteArrayView trailer(checkSequence, QSerialPortCrc::store(check, frame, checkSequence));
+
+    switch (framingMode) {
+    case QSerialPort::SlipFraming:
+    case QSerialPort::HdlcFraming:
+        return encodeEscaped(escapeScheme(framingMode), { frame, trailer }, out);
+    case QSerialPort::CobsFraming:
+        return encodeCobs({ frame, trailer }, out);
+    default:
+        return 0;
+    }
+}
+
+void QSerialPortFrameCodec::decode(QByteArrayView data, QList<QByteArray> *frames)
+{
+    switch (framingMode) {
+    case QSerialPort::SlipFraming:
+    case QSerialPort::HdlcFraming:
+        decodeEscaped(data, frames);
+        break;
+    case QSerialPort::CobsFraming:
+        decodeCobs(data, frames);
+        break;
+    default:
+        break;
+    }
+}
+
+void QSerialPortFrameCodec::decodeEscaped(QByteArrayView data, QList<QByteArray> *frames)
+{
+    const EscapeScheme &scheme = escapeScheme(framingMode);
+
+    const char *p = data.data();
+    const char *const end = p + data.size();
+    while (p < end) {
+        if (escaped) {
+            escaped = false;
+            const quint8 c = quint8(*p++);
+            if (c == scheme.flag) {
+                // An escaped flag aborts the frame
+                dropFrame();
+                continue;
+            }
+            const char unescaped = char(scheme.unescaped(c));
+            append(&unescaped, 1);
+            continue;
+        }
+
+        const char *run = p;
+        while (p < end && !scheme.special[quint8(*p)])
+            ++p;
+        append(run, p - run);
+        if (p == end)
+            break;
+
+        if (quint8(*p++) == scheme.flag)
+            finishFrame(frames);
+        else
+            escaped = true;
+    }
+}
+
+void QSerialPortFrameCodec::decodeCobs(QByteArrayView data, QList<QByteArray> *frames)
+{
+    const char *p = data.data();
+    const char *const end = p + data.size();
+    while (p < end) {
+        if (cobsRemaining == 0) {
+            const quint8 length = quint8(*p++);
+            if (length == 0) {
+                // The zero after the last block is implied by the delimiter
+                finishFrame(frames);
+                continue;
+            }
+            if (cobsZeroPending)
+                append("", 1);
+            cobsRemaining = length - 1;
+            cobsZeroPending = length < 0xff;
+            continue;
+        }
+
+        const qint64 size = qMin<qint64>(cobsRemaining, end - p);
+        if (const void *zero = ::memchr(p, 0, size)) {
+            // A delimiter inside a block, the frame was cut short
+            dropFrame();
+            p = static_cast<const char *>(zero) + 1;
+            continue;
+        }
+        append(p, size);
+        p += size;
+        cobsRemaining -= int(size);
+    }
+}
+
+void QSerialPortFrameCodec::append(const char *data, qint64 size)
+{
+    if (oversized || size == 0)
+        return;
+    if (frame.size() + size > QSERIALPORT_MAXFRAMESIZE) {
+        // Drop the rest of it up to the next delimiter
+        frame.clear();
+        oversized = true;
+        return;
+    }
+    frame.append(data, size);
+}
+
+void QSerialPortFrameCodec::finishFrame(QList<QByteArray> *frames)
+{
+    if (!oversized && !frame.isEmpty()) {
+        if (check == QSerialPort::NoFrameCheck) {
+            frames->append(std::exchange(frame, QByteArray()));
+        } else if (frame.size() > QSerialPortCrc::size(check)
+                   && QSerialPortCrc::verify(check, frame)) {
+            frame.chop(QSerialPortCrc::size(check));
+            frames->append(std::exchange(frame, QByteArray()));
+        } else {
+            ++checkErrors;
+        }
+    }
+    dropFrame();
+}
+
+void QSerialPortFrameCodec::dropFrame()
+{
+    frame.clear();
+    escaped = false;
+    oversized = false;
+    cobsRemaining = 0;
+    cobsZeroPending = false;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,70 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTFRAMING_P_H
+#define QSERIALPORTFRAMING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialport.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+
+// Frames growing beyond this size are dropped by the decoder
+#ifndef QSERIALPORT_MAXFRAMESIZE
+#define QSERIALPORT_MAXFRAMESIZE (1024 * 1024)
+#endif
+
+QT_BEGIN_NAMESPACE
+
+// Incremental codec for the byte-stuffed framings of QSerialPort::Framing.
+// Encoding works on a whole frame, decoding on whatever was read so far;
+// a frame split over several reads is completed by later decode() calls.
+// With a frame check set, the check sequence is appended when encoding, and
+// verified and stripped when decoding.
+class QSerialPortFrameCodec
+{
+public:
+    QSerialPort::Framing framing() const { return framingMode; }
+    void reset(QSerialPort::Framing framing);
+
+    QSerialPort::FrameCheck frameCheck() const { return check; }
+    void setFrameCheck(QSerialPort::FrameCheck frameCheck);
+    qint64 frameCheckErrorCount() const { return checkErrors; }
+    void resetFrameCheckErrorCount() { checkErrors = 0; }
+
+    qint64 maximumEncodedSize(qint64 size) const;
+    qint64 encode(QByteArrayView frame, char *out) const;
+
+    void decode(QByteArrayView data, QList<QByteArray> *frames);
+
+private:
+    void decodeEscaped(QByteArrayView data, QList<QByteArray> *frames);
+    void decodeCobs(QByteArrayView data, QList<QByteArray> *frames);
+    void append(const char *data, qint64 size);
+    void finishFrame(QList<QByteArray> *frames);
+    void dropFrame();
+
+    QSerialPort::Framing framingMode = QSerialPort::NoFraming;
+    QSerialPort::FrameCheck check = QSerialPort::NoFrameCheck;
+    qint64 checkErrors = 0;
+    QByteArray frame;
+    bool escaped = false;
+    bool oversized = false;
+    int cobsRemaining = 0;      // data bytes left in the current COBS block
+    bool cobsZeroPending = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTFRAMING_P_H
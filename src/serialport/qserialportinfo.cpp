@@ -8,6 +8,12 @@
 #include "qserialport.h"
 #include "qserialport_p.h"
 
+#include <QtCore/qmutex.h>
+#if QT_CONFIG(future)
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 // We changed from QScopedPointer to std::unique_ptr, make sure it's
@@ -149,7 +155,10 @@ QString QSerialPortInfo::systemLocation() const
 QString QSerialPortInfo::description() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? QString() : d->description;
+    if (!d)
+        return QString();
+    d->resolveDetails();
+    return d->description;
 }
 
 /*!
@@ -161,7 +170,10 @@ QString QSerialPortInfo::description() const
 QString QSerialPortInfo::manufacturer() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? QString() : d->manufacturer;
+    if (!d)
+        return QString();
+    d->resolveDetails();
+    return d->manufacturer;
 }
 
 /*!
@@ -177,7 +189,10 @@ QString QSerialPortInfo::manufacturer() const
 QString QSerialPortInfo::serialNumber() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? QString() : d->serialNumber;
+    if (!d)
+        return QString();
+    d->resolveDetails();
+    return d->serialNumber;
 }
 
 /*!
@@ -189,7 +204,10 @@ QString QSerialPortInfo::serialNumber() const
 quint16 QSerialPortInfo::vendorIdentifier() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? 0 : d->vendorIdentifier;
+    if (!d)
+        return 0;
+    d->resolveDetails();
+    return d->vendorIdentifier;
 }
 
 /*!
@@ -201,7 +219,10 @@ quint16 QSerialPortInfo::vendorIdentifier() const
 quint16 QSerialPortInfo::productIdentifier() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? 0 : d->productIdentifier;
+    if (!d)
+        return 0;
+    d->resolveDetails();
+    return d->productIdentifier;
 }
 
 /*!
@@ -213,7 +234,10 @@ quint16 QSerialPortInfo::productIdentifier() const
 bool QSerialPortInfo::hasVendorIdentifier() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? false : d->hasVendorIdentifier;
+    if (!d)
+        return false;
+    d->resolveDetails();
+    return d->hasVendorIdentifier;
 }
 
 /*!
@@ -225,7 +249,28 @@ bool QSerialPortInfo::hasVendorIdentifier() const
 bool QSerialPortInfo::hasProductIdentifier() const
 {
     Q_D(const QSerialPortInfo);
-    return !d ? false : d->hasProductIdentifier;
+    if (!d)
+        return false;
+    d->resolveDetails();
+    return d->hasProductIdentifier;
+}
+
+/*!
+    \since 6.9
+
+    Returns the hardware capabilities of the serial port.
+
+    The capabilities are gathered once, while the available ports are
+    enumerated, so calling this function does not access the device.
+    They are only available on Linux; on other platforms, and for ports
+    whose driver does not report them, all values are zero or empty.
+
+    \sa QSerialPortCapabilities
+*/
+QSerialPortCapabilities QSerialPortInfo::capabilities() const
+{
+    Q_D(const QSerialPortInfo);
+    return !d ? QSerialPortCapabilities() : QSerialPortCapabilities(*d);
 }
 
 /*!
@@ -250,6 +295,216 @@ QList<qint32> QSerialPortInfo::standardBaudRates()
     \fn QList<QSerialPortInfo> QSerialPortInfo::availablePorts()
 
     Returns a list of available serial ports on the system.
+
+    \sa availablePortsAsync(), setEnumerationCacheFileName()
+*/
+
+#if QT_CONFIG(future)
+/*!
+    \since 6.9
+
+    Enumerates the available serial ports on a thread of
+    QThreadPool::globalInstance() and returns a future that receives the
+    list of ports when the enumeration is done.
+
+    Unlike availablePorts(), this does not block the calling thread while
+    libudev is loaded, sysfs is read, or devices are opened to check them.
+    Cancelling the future before the enumeration starts skips it.
+
+    \sa availablePorts()
+*/
+QFuture<QList<QSerialPortInfo>> QSerialPortInfo::availablePortsAsync()
+{
+    QPromise<QList<QSerialPortInfo>> promise;
+    QFuture<QList<QSerialPortInfo>> future = promise.future();
+    promise.start();
+    QThreadPool::globalInstance()->start([promise = std::move(promise)]() mutable {
+        if (!promise.isCanceled()) {
+            QList<QSerialPortInfo> ports = availablePorts();
+            // Read the details here rather than on the thread of the caller
+            for (const QSerialPortInfo &info : std::as_const(ports))
+                info.d_func()->resolveDetails();
+            promise.addResult(std::move(ports));
+        }
+        promise.finish();
+    });
+    return future;
+}
+#endif
+
+namespace {
+struct QSerialPortInfoCacheSettings
+{
+    QMutex mutex;
+    QString fileName;
+};
+}
+
+Q_GLOBAL_STATIC(QSerialPortInfoCacheSettings, cacheSettings)
+
+/*!
+    \since 6.9
+
+    Makes availablePorts() keep the result of the last enumeration in the
+    file \a fileName, and return it without scanning the system again as
+    long as the set of serial devices is unchanged. An empty \a fileName
+    disables the cache, which is the default.
+
+    Whether the devices changed is decided by a fingerprint of the
+    entries of \c{/sys/class/tty} and \c{/dev}, which is much cheaper to
+    take than a full enumeration. The cache is not used on Windows, \macos
+    and FreeBSD.
+
+    \sa enumerationCacheFileName()
+*/
+void QSerialPortInfo::setEnumerationCacheFileName(const QString &fileName)
+{
+    QMutexLocker locker(&cacheSettings->mutex);
+    cacheSettings->fileName = fileName;
+}
+
+/*!
+    \since 6.9
+
+    Returns the file in which availablePorts() keeps the last enumeration
+    result, or an empty string if the cache is disabled.
+
+    \sa setEnumerationCacheFileName()
+*/
+QString QSerialPortInfo::enumerationCacheFileName()
+{
+    QMutexLocker locker(&cacheSettings->mutex);
+    return cacheSettings->fileName;
+}
+
+class QSerialPortCapabilitiesPrivate : public QSharedData
+{
+public:
+    QString driver;
+    qint64 usbSpeed = 0;
+    qint32 maximumBaudRate = 0;
+    int fifoSize = 0;
+    bool hasCustomBaudRateDivisor = false;
+};
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QSerialPortCapabilitiesPrivate)
+
+/*!
+    \class QSerialPortCapabilities
+    \since 6.9
+
+    \brief Describes what the hardware behind a serial port supports.
+
+    \ingroup serialport-main
+    \inmodule QtSerialPort
+
+    The capabilities of an available port are returned by
+    QSerialPortInfo::capabilities(). They allow an application to pick
+    the baud rate and the buffer sizes for a device without probing it.
+
+    A value that the driver does not report is zero or empty.
+
+    \sa QSerialPortInfo
+*/
+
+/*!
+    Constructs a QSerialPortCapabilities object with no capabilities
+    known.
+*/
+QSerialPortCapabilities::QSerialPortCapabilities()
+    : d(new QSerialPortCapabilitiesPrivate)
+{
+}
+
+QSerialPortCapabilities::QSerialPortCapabilities(const QSerialPortInfoPrivate &info)
+    : d(new QSerialPortCapabilitiesPrivate)
+{
+    d->driver = info.driver;
+    d->usbSpeed = info.usbSpeed;
+    d->maximumBaudRate = info.maximumBaudRate;
+    d->fifoSize = info.fifoSize;
+    d->hasCustomBaudRateDivisor = info.hasCustomBaudRateDivisor;
+}
+
+/*!
+    Constructs a copy of \a other.
 */
+QSerialPortCapabilities::QSerialPortCapabilities(const QSerialPortCapabilities &other) = default;
+
+/*!
+    \fn QSerialPortCapabilities::QSerialPortCapabilities(QSerialPortCapabilities &&other)
+
+    Move-constructs a QSerialPortCapabilities object from \a other.
+*/
+
+/*!
+    Destroys the QSerialPortCapabilities object.
+*/
+QSerialPortCapabilities::~QSerialPortCapabilities() = default;
+
+/*!
+    Assigns \a other to this object.
+*/
+QSerialPortCapabilities &QSerialPortCapabilities::operator=(const QSerialPortCapabilities &other) = default;
+
+/*!
+    \fn void QSerialPortCapabilities::swap(QSerialPortCapabilities &other)
+
+    Swaps this object with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns the highest baud rate the UART can be programmed to, or zero
+    if it is not known.
+
+    For UARTs handled by the Linux serial core this is the base baud rate,
+    i.e. the rate at a divisor of one.
+*/
+qint32 QSerialPortCapabilities::maximumBaudRate() const
+{
+    return d->maximumBaudRate;
+}
+
+/*!
+    Returns the size of the transmit FIFO of the UART in bytes, or zero if
+    it is not known.
+*/
+int QSerialPortCapabilities::fifoSize() const
+{
+    return d->fifoSize;
+}
+
+/*!
+    Returns \c true if the driver accepts a custom baud rate divisor, so
+    that rates other than the standard ones can be set.
+
+    \sa QSerialPort::setBaudRate()
+*/
+bool QSerialPortCapabilities::hasCustomBaudRateDivisor() const
+{
+    return d->hasCustomBaudRateDivisor;
+}
+
+/*!
+    Returns the bus speed of the USB device that provides the serial port,
+    in bits per second, or zero if the port is not on USB.
+
+    For example, a full speed device returns 12000000 and a high speed
+    device 480000000.
+*/
+qint64 QSerialPortCapabilities::usbSpeed() const
+{
+    return d->usbSpeed;
+}
+
+/*!
+    Returns the name of the kernel driver of the serial port, for example
+    \c serial8250 or \c ftdi_sio, or an empty string if it is not known.
+*/
+QString QSerialPortCapabilities::driver() const
+{
+    return d->driver;
+}
 
 QT_END_NAMESPACE
@@ -6,7 +6,11 @@
 #define QSERIALPORTINFO_H
 
 #include <QtCore/qlist.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qshareddata.h>
 
 #include <QtSerialPort/qserialportglobal.h>
 
@@ -14,6 +18,35 @@ QT_BEGIN_NAMESPACE
 
 class QSerialPort;
 class QSerialPortInfoPrivate;
+class QSerialPortCapabilitiesPrivate;
+QT_DECLARE_QSDP_SPECIALIZATION_DTOR_WITH_EXPORT(QSerialPortCapabilitiesPrivate, Q_SERIALPORT_EXPORT)
+
+class Q_SERIALPORT_EXPORT QSerialPortCapabilities
+{
+public:
+    QSerialPortCapabilities();
+    QSerialPortCapabilities(const QSerialPortCapabilities &other);
+    QSerialPortCapabilities(QSerialPortCapabilities &&other) noexcept = default;
+    ~QSerialPortCapabilities();
+
+    QSerialPortCapabilities &operator=(const QSerialPortCapabilities &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QSerialPortCapabilities)
+    void swap(QSerialPortCapabilities &other) noexcept { d.swap(other.d); }
+
+    qint32 maximumBaudRate() const;
+    int fifoSize() const;
+    bool hasCustomBaudRateDivisor() const;
+    qint64 usbSpeed() const;
+    QString driver() const;
+
+private:
+    friend class QSerialPortInfo;
+    explicit QSerialPortCapabilities(const QSerialPortInfoPrivate &info);
+
+    QSharedDataPointer<QSerialPortCapabilitiesPrivate> d;
+};
+
+Q_DECLARE_SHARED(QSerialPortCapabilities)
 
 class Q_SERIALPORT_EXPORT QSerialPortInfo
 {
@@ -42,8 +75,16 @@ public:
 
     bool isNull() const;
 
+    QSerialPortCapabilities capabilities() const;
+
     static QList<qint32> standardBaudRates();
     static QList<QSerialPortInfo> availablePorts();
+#if QT_CONFIG(future)
+    static QFuture<QList<QSerialPortInfo>> availablePortsAsync();
+#endif
+
+    static void setEnumerationCacheFileName(const QString &fileName);
+    static QString enumerationCacheFileName();
 
 private:
     QSerialPortInfo(const QSerialPortInfoPrivate &dd);
@@ -17,9 +17,15 @@
 // We mean it.
 //
 
+#include <QtCore/qatomic.h>
 #include <QtCore/qstring.h>
 #include <QtCore/private/qglobal_p.h>
 
+// The generic Unix enumeration resolves the descriptive fields on demand
+#if defined(Q_OS_UNIX) && !defined(Q_OS_DARWIN) && !defined(Q_OS_FREEBSD)
+#  define QSERIALPORTINFO_LAZY_DETAILS
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class Q_AUTOTEST_EXPORT QSerialPortInfoPrivate
@@ -28,6 +34,16 @@ public:
     static QString portNameToSystemLocation(const QString &source);
     static QString portNameFromSystemLocation(const QString &source);
 
+    // Fills description, manufacturer, serialNumber and the identifiers
+    // if the enumeration left them to be read from sysPath
+    void resolveDetails() const
+    {
+#ifdef QSERIALPORTINFO_LAZY_DETAILS
+        if (detailsPending.loadAcquire())
+            resolvePendingDetails();
+#endif
+    }
+
     QString portName;
     QString device;
     QString description;
@@ -39,6 +55,23 @@ public:
 
     bool hasVendorIdentifier = false;
     bool hasProductIdentifier = false;
+
+    // Gathered during enumeration for QSerialPortCapabilities
+    QString driver;
+    qint64 usbSpeed = 0;
+    qint32 maximumBaudRate = 0;
+    int fifoSize = 0;
+    bool hasCustomBaudRateDivisor = false;
+
+#ifdef QSERIALPORTINFO_LAZY_DETAILS
+    void resolvePendingDetails() const;
+
+    enum DetailsSource { SysfsDetails, UdevDetails };
+
+    QString sysPath;
+    DetailsSource detailsSource = SysfsDetails;
+    QAtomicInt detailsPending;
+#endif
 };
 
 QT_END_NAMESPACE
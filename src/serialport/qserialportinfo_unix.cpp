@@ -10,12 +10,20 @@
 #include <QtCore/qlockfile.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
 
 #include <private/qcore_unix_p.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
+#include <dirent.h>
 #include <errno.h>
+#include <sys/stat.h>
 #include <sys/types.h> // kill
 #include <signal.h>    // kill
 
@@ -98,20 +106,26 @@ static bool isSerial8250Driver(const QString &driverName)
     return (driverName == QLatin1String("serial8250"));
 }
 
-static bool isValidSerial8250(const QString &systemLocation)
+// Also takes the capabilities of the UART from the serial_struct that is
+// read anyway to tell a present 8250 from an empty slot
+static bool isValidSerial8250(QSerialPortInfoPrivate &priv)
 {
 #ifdef Q_OS_LINUX
     const mode_t flags = O_RDWR | O_NONBLOCK | O_NOCTTY;
-    const int fd = qt_safe_open(systemLocation.toLocal8Bit().constData(), flags);
+    const int fd = qt_safe_open(priv.device.toLocal8Bit().constData(), flags);
     if (fd != -1) {
         struct serial_struct serinfo;
         const int retval = ::ioctl(fd, TIOCGSERIAL, &serinfo);
         qt_safe_close(fd);
-        if (retval != -1 && serinfo.type != PORT_UNKNOWN)
+        if (retval != -1 && serinfo.type != PORT_UNKNOWN) {
+            priv.maximumBaudRate = serinfo.baud_base;
+            priv.fifoSize = serinfo.xmit_fifo_size;
+            priv.hasCustomBaudRateDivisor = serinfo.baud_base > 0;
             return true;
+        }
     }
 #else
-    Q_UNUSED(systemLocation);
+    Q_UNUSED(priv);
 #endif
     return false;
 }
@@ -209,6 +223,77 @@ static QString deviceSerialNumber(const QDir &targetDir)
     return deviceProperty(QFileInfo(targetDir, QStringLiteral("serial")).absoluteFilePath());
 }
 
+// Reads the capabilities that sysfs exposes without opening the device:
+// the UART attributes of the serial core, and the bus speed of the USB
+// device the port belongs to.
+static void deviceCapabilities(QSerialPortInfoPrivate &priv, const QString &driverName)
+{
+#ifdef Q_OS_LINUX
+    priv.driver = driverName;
+
+    QDir targetDir(QLatin1String("/sys/class/tty/") + priv.portName);
+    if (!targetDir.exists())
+        return;
+
+    if (priv.maximumBaudRate == 0) {
+        bool ok = false;
+        const qint64 clock = deviceProperty(
+                    QFileInfo(targetDir, QStringLiteral("uartclk")).absoluteFilePath()).toLongLong(&ok);
+        if (ok && clock > 0) {
+            priv.maximumBaudRate = qint32(qMin(clock / 16, qint64(std::numeric_limits<qint32>::max())));
+            priv.hasCustomBaudRateDivisor = true;
+        }
+    }
+    if (priv.fifoSize == 0) {
+        priv.fifoSize = deviceProperty(
+                    QFileInfo(targetDir, QStringLiteral("xmit_fifo_size")).absoluteFilePath()).toInt();
+    }
+
+    targetDir.setPath(targetDir.canonicalPath());
+    while (targetDir.cdUp() && targetDir.absolutePath() != QLatin1String("/sys/devices")) {
+        // USB devices, unlike their interfaces, have the idVendor attribute
+        if (!targetDir.exists(QStringLiteral("idVendor")))
+            continue;
+        const double speed = deviceProperty(
+                    QFileInfo(targetDir, QStringLiteral("speed")).absoluteFilePath()).toDouble();
+        priv.usbSpeed = qint64(speed * 1000000);
+        break;
+    }
+#else
+    Q_UNUSED(priv);
+    Q_UNUSED(driverName);
+#endif
+}
+
+static void sysfsDetails(QSerialPortInfoPrivate &priv)
+{
+    QDir targetDir(priv.sysPath);
+    do {
+        if (priv.description.isEmpty())
+            priv.description = deviceDescription(targetDir);
+
+        if (priv.manufacturer.isEmpty())
+            priv.manufacturer = deviceManufacturer(targetDir);
+
+        if (priv.serialNumber.isEmpty())
+            priv.serialNumber = deviceSerialNumber(targetDir);
+
+        if (!priv.hasVendorIdentifier)
+            priv.vendorIdentifier = deviceVendorIdentifier(targetDir, priv.hasVendorIdentifier);
+
+        if (!priv.hasProductIdentifier)
+            priv.productIdentifier = deviceProductIdentifier(targetDir, priv.hasProductIdentifier);
+
+        if (!priv.description.isEmpty()
+                || !priv.manufacturer.isEmpty()
+                || !priv.serialNumber.isEmpty()
+                || priv.hasVendorIdentifier
+                || priv.hasProductIdentifier) {
+            break;
+        }
+    } while (targetDir.cdUp());
+}
+
 QList<QSerialPortInfo> availablePortsBySysfs(bool &ok)
 {
     QDir ttySysClassDir(QStringLiteral("/sys/class/tty"));
@@ -243,34 +328,14 @@ QList<QSerialPortInfo> availablePortsBySysfs(bool &ok)
         }
 
         priv.device = QSerialPortInfoPrivate::portNameToSystemLocation(priv.portName);
-        if (isSerial8250Driver(driverName) && !isValidSerial8250(priv.device))
+        if (isSerial8250Driver(driverName) && !isValidSerial8250(priv))
             continue;
 
-        do {
-            if (priv.description.isEmpty())
-                priv.description = deviceDescription(targetDir);
-
-            if (priv.manufacturer.isEmpty())
-                priv.manufacturer = deviceManufacturer(targetDir);
-
-            if (priv.serialNumber.isEmpty())
-                priv.serialNumber = deviceSerialNumber(targetDir);
-
-            if (!priv.hasVendorIdentifier)
-                priv.vendorIdentifier = deviceVendorIdentifier(targetDir, priv.hasVendorIdentifier);
-
-            if (!priv.hasProductIdentifier)
-                priv.productIdentifier = deviceProductIdentifier(targetDir, priv.hasProductIdentifier);
-
-            if (!priv.description.isEmpty()
-                    || !priv.manufacturer.isEmpty()
-                    || !priv.serialNumber.isEmpty()
-                    || priv.hasVendorIdentifier
-                    || priv.hasProductIdentifier) {
-                break;
-            }
-        } while (targetDir.cdUp());
+        priv.sysPath = targetDir.absolutePath();
+        priv.detailsSource = QSerialPortInfoPrivate::SysfsDetails;
+        priv.detailsPending.storeRelaxed(1);
 
+        deviceCapabilities(priv, driverName);
         serialPortInfoList.append(priv);
     }
 
@@ -344,6 +409,24 @@ static QString deviceLocation(struct ::udev_device *dev)
     return QString::fromLatin1(::udev_device_get_devnode(dev));
 }
 
+static void udevDetails(QSerialPortInfoPrivate &priv)
+{
+    const udev_ptr<struct ::udev> udev(::udev_new());
+    if (!udev)
+        return;
+
+    const udev_ptr<udev_device>
+            dev(::udev_device_new_from_syspath(udev.get(), priv.sysPath.toLocal8Bit().constData()));
+    if (!dev)
+        return;
+
+    priv.description = deviceDescription(dev.get());
+    priv.manufacturer = deviceManufacturer(dev.get());
+    priv.serialNumber = deviceSerialNumber(dev.get());
+    priv.vendorIdentifier = deviceVendorIdentifier(dev.get(), priv.hasVendorIdentifier);
+    priv.productIdentifier = deviceProductIdentifier(dev.get(), priv.hasProductIdentifier);
+}
+
 QList<QSerialPortInfo> availablePortsByUdev(bool &ok)
 {
     ok = false;
@@ -391,13 +474,12 @@ QList<QSerialPortInfo> availablePortsByUdev(bool &ok)
 
         if (parentdev) {
             const QString driverName = deviceDriver(parentdev);
-            if (isSerial8250Driver(driverName) && !isValidSerial8250(priv.device))
+            if (isSerial8250Driver(driverName) && !isValidSerial8250(priv))
                 continue;
-            priv.description = deviceDescription(dev.get());
-            priv.manufacturer = deviceManufacturer(dev.get());
-            priv.serialNumber = deviceSerialNumber(dev.get());
-            priv.vendorIdentifier = deviceVendorIdentifier(dev.get(), priv.hasVendorIdentifier);
-            priv.productIdentifier = deviceProductIdentifier(dev.get(), priv.hasProductIdentifier);
+            priv.sysPath = QString::fromLocal8Bit(::udev_list_entry_get_name(dev_list_entry));
+            priv.detailsSource = QSerialPortInfoPrivate::UdevDetails;
+            priv.detailsPending.storeRelaxed(1);
+            deviceCapabilities(priv, driverName);
         } else {
             if (!isRfcommDevice(priv.portName)
                     && !isVirtualNullModemDevice(priv.portName)
@@ -412,7 +494,113 @@ QList<QSerialPortInfo> availablePortsByUdev(bool &ok)
     return serialPortInfoList;
 }
 
-QList<QSerialPortInfo> QSerialPortInfo::availablePorts()
+enum { EnumerationCacheMagic = 0x51535043, EnumerationCacheVersion = 1 };
+
+// Hashes the names and inode numbers of the entries of the directories
+// that serial devices appear in. A device that is added, removed or
+// recreated changes the fingerprint, without stat()ing every entry.
+static QByteArray enumerationFingerprint()
+{
+    static const char *const directories[] = {
+#ifdef Q_OS_LINUX
+        "/sys/class/tty",
+#endif
+        "/dev"
+    };
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const char *directory : directories) {
+        QT_STATBUF directoryInfo;
+        if (QT_STAT(directory, &directoryInfo) == -1)
+            continue;
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&directoryInfo.st_ino),
+                                    sizeof(directoryInfo.st_ino)));
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&directoryInfo.st_mtime),
+                                    sizeof(directoryInfo.st_mtime)));
+
+        DIR *dir = ::opendir(directory);
+        if (!dir)
+            continue;
+        QList<QByteArray> entries;
+        while (const dirent *entry = ::readdir(dir)) {
+            QByteArray item(entry->d_name);
+            const quint64 inode = entry->d_ino;
+            item.append(reinterpret_cast<const char *>(&inode), sizeof(inode));
+            entries.append(item);
+        }
+        ::closedir(dir);
+
+        // The order of readdir() is not guaranteed to be stable
+        std::sort(entries.begin(), entries.end());
+        for (const QByteArray &item : std::as_const(entries))
+            hash.addData(item);
+    }
+    return hash.result();
+}
+
+static bool readEnumerationCache(const QString &fileName, const QByteArray &fingerprint,
+                                 QList<QSerialPortInfoPrivate> *cachedPorts)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray cachedFingerprint;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (magic != EnumerationCacheMagic || version != EnumerationCacheVersion)
+        return false;
+    in >> cachedFingerprint >> count;
+    if (cachedFingerprint != fingerprint || count < 0)
+        return false;
+
+    QList<QSerialPortInfoPrivate> result;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QSerialPortInfoPrivate priv;
+        in >> priv.portName >> priv.device >> priv.description >> priv.manufacturer
+           >> priv.serialNumber >> priv.vendorIdentifier >> priv.productIdentifier
+           >> priv.hasVendorIdentifier >> priv.hasProductIdentifier
+           >> priv.driver >> priv.usbSpeed >> priv.maximumBaudRate >> priv.fifoSize
+           >> priv.hasCustomBaudRateDivisor;
+        result.append(priv);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    *cachedPorts = std::move(result);
+    return true;
+}
+
+static void writeEnumerationCache(const QString &fileName, const QByteArray &fingerprint,
+                                  const QList<QSerialPortInfo> &serialPortInfoList)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint32(EnumerationCacheMagic) << quint32(EnumerationCacheVersion)
+        << fingerprint << qint32(serialPortInfoList.size());
+    for (const QSerialPortInfo &info : serialPortInfoList) {
+        const QSerialPortCapabilities capabilities = info.capabilities();
+        out << info.portName() << info.systemLocation() << info.description()
+            << info.manufacturer() << info.serialNumber()
+            << info.vendorIdentifier() << info.productIdentifier()
+            << info.hasVendorIdentifier() << info.hasProductIdentifier()
+            << capabilities.driver() << capabilities.usbSpeed()
+            << capabilities.maximumBaudRate() << qint32(capabilities.fifoSize())
+            << capabilities.hasCustomBaudRateDivisor();
+    }
+    if (out.status() == QDataStream::Ok)
+        file.commit();
+}
+
+static QList<QSerialPortInfo> scanAvailablePorts()
 {
     bool ok;
 
@@ -429,6 +617,47 @@ QList<QSerialPortInfo> QSerialPortInfo::availablePorts()
     return serialPortInfoList;
 }
 
+QList<QSerialPortInfo> QSerialPortInfo::availablePorts()
+{
+    const QString cacheFileName = enumerationCacheFileName();
+    if (cacheFileName.isEmpty())
+        return scanAvailablePorts();
+
+    // The fingerprint is taken before the scan, so that a device that
+    // appears during the scan invalidates the cache on the next call
+    const QByteArray fingerprint = enumerationFingerprint();
+    QList<QSerialPortInfo> serialPortInfoList;
+    QList<QSerialPortInfoPrivate> cachedPorts;
+    if (readEnumerationCache(cacheFileName, fingerprint, &cachedPorts)) {
+        serialPortInfoList.reserve(cachedPorts.size());
+        for (const QSerialPortInfoPrivate &priv : std::as_const(cachedPorts))
+            serialPortInfoList.append(QSerialPortInfo(priv));
+        return serialPortInfoList;
+    }
+
+    serialPortInfoList = scanAvailablePorts();
+    writeEnumerationCache(cacheFileName, fingerprint, serialPortInfoList);
+    return serialPortInfoList;
+}
+
+Q_CONSTINIT static QBasicMutex detailsMutex;
+
+void QSerialPortInfoPrivate::resolvePendingDetails() const
+{
+    const QMutexLocker locker(&detailsMutex);
+    if (!detailsPending.loadRelaxed())
+        return;
+
+    // The private object is never created const; only the accessors of
+    // QSerialPortInfo, which trigger this, are
+    auto self = const_cast<QSerialPortInfoPrivate *>(this);
+    if (detailsSource == UdevDetails)
+        udevDetails(*self);
+    else
+        sysfsDetails(*self);
+    self->detailsPending.storeRelease(0);
+}
+
 QString QSerialPortInfoPrivate::portNameToSystemLocation(const QString &source)
 {
     return (source.startsWith(QLatin1Char('/'))
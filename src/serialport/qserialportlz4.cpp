@@ -0,0 +1,183 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportlz4_p.h"
+
+#include <QtCore/qendian.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum {
+    MinMatch = 4,
+    // The last five bytes are always literals, and the last match starts
+    // at least twelve bytes before the end of the block
+    LastLiterals = 5,
+    MatchFindLimit = 12,
+    HashLog = 12,
+    MaxOffset = 65535
+};
+
+inline quint32 read32(const uchar *p)
+{
+    return qFromUnaligned<quint32>(p);
+}
+
+inline quint32 hashSequence(quint32 sequence)
+{
+    return (sequence * 2654435761U) >> (32 - HashLog);
+}
+
+// Writes the length remaining after the 4 bits of the token
+inline uchar *writeLength(uchar *op, qsizetype length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = uchar(length);
+    return op;
+}
+
+inline bool readLength(const uchar *&ip, const uchar *end, qsizetype *length)
+{
+    uchar b;
+    do {
+        if (ip >= end)
+            return false;
+        b = *ip++;
+        *length += b;
+    } while (b == 255);
+    return true;
+}
+
+// Appends a sequence of the literals [anchor, anchor + literals) and, if
+// matchLength is not 0, a match; returns nullptr if it does not fit.
+uchar *writeSequence(uchar *op, uchar *end, const uchar *anchor, qsizetype literals,
+                     qsizetype offset, qsizetype matchLength)
+{
+    const qsizetype required = 1 + (literals / 255 + 1) + literals
+            + (matchLength ? 2 + (matchLength - MinMatch) / 255 + 1 : 0);
+    if (required > end - op)
+        return nullptr;
+
+    uchar *token = op++;
+    *token = uchar(qMin<qsizetype>(literals, 15) << 4);
+    if (literals >= 15)
+        op = writeLength(op, literals - 15);
+    ::memcpy(op, anchor, literals);
+    op += literals;
+
+    if (matchLength) {
+        qToLittleEndian<quint16>(quint16(offset), op);
+        op += 2;
+        const qsizetype length = matchLength - MinMatch;
+        *token |= uchar(qMin<qsizetype>(length, 15));
+        if (length >= 15)
+            op = writeLength(op, length - 15);
+    }
+    return op;
+}
+
+} // namespace
+
+qsizetype QSerialPortLz4::compress(const char *src, qsizetype size, char *dst, qsizetype capacity)
+{
+    const auto base = reinterpret_cast<const uchar *>(src);
+    const uchar *const end = base + size;
+    const uchar *ip = base;
+    const uchar *anchor = base;
+    auto op = reinterpret_cast<uchar *>(dst);
+    uchar *const opEnd = op + capacity;
+
+    if (size > MatchFindLimit) {
+        const uchar *const matchLimit = end - LastLiterals;
+        const uchar *const findLimit = end - MatchFindLimit;
+        quint16 table[1 << HashLog] = {};
+
+        ++ip;
+        while (ip <= findLimit) {
+            const quint32 sequence = read32(ip);
+            quint16 &entry = table[hashSequence(sequence)];
+            const uchar *ref = base + entry;
+            entry = quint16(ip - base);
+            if (ref >= ip || ip - ref > MaxOffset || read32(ref) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            const uchar *matchEnd = ip + MinMatch;
+            const uchar *refEnd = ref + MinMatch;
+            while (matchEnd < matchLimit && *matchEnd == *refEnd) {
+                ++matchEnd;
+                ++refEnd;
+            }
+
+            op = writeSequence(op, opEnd, anchor, ip - anchor, ip - ref, matchEnd - ip);
+            if (!op)
+                return 0;
+            ip = matchEnd;
+            anchor = ip;
+        }
+    }
+
+    op = writeSequence(op, opEnd, anchor, end - anchor, 0, 0);
+    if (!op)
+        return 0;
+    return op - reinterpret_cast<uchar *>(dst);
+}
+
+qsizetype QSerialPortLz4::decompress(const char *src, qsizetype size, char *dst, qsizetype capacity)
+{
+    auto ip = reinterpret_cast<const uchar *>(src);
+    const uchar *const end = ip + size;
+    const auto base = reinterpret_cast<uchar *>(dst);
+    uchar *op = base;
+    uchar *const opEnd = base + capacity;
+
+    while (ip < end) {
+        const uchar token = *ip++;
+
+        qsizetype literals = token >> 4;
+        if (literals == 15 && !readLength(ip, end, &literals))
+            return -1;
+        if (literals > end - ip || literals > opEnd - op)
+            return -1;
+        ::memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+
+        // The last sequence has no match
+        if (ip == end)
+            break;
+
+        if (end - ip < 2)
+            return -1;
+        const qsizetype offset = qFromLittleEndian<quint16>(ip);
+        ip += 2;
+        if (offset == 0 || offset > op - base)
+            return -1;
+
+        qsizetype length = token & 15;
+        if (length == 15 && !readLength(ip, end, &length))
+            return -1;
+        length += MinMatch;
+        if (length > opEnd - op)
+            return -1;
+
+        // The match may overlap the data it produces, copy byte by byte
+        const uchar *ref = op - offset;
+        for (qsizetype i = 0; i < length; ++i)
+            op[i] = ref[i];
+        op += length;
+    }
+
+    return op - base;
+}
+
+QT_END_NAMESPACE
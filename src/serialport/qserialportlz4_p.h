@@ -0,0 +1,54 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTLZ4_P_H
+#define QSERIALPORTLZ4_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+// Uncompressed size of the blocks of QSerialPort::Lz4Compression, in bytes
+#ifndef QSERIALPORT_LZ4BLOCKSIZE
+#define QSERIALPORT_LZ4BLOCKSIZE 4096
+#endif
+
+QT_BEGIN_NAMESPACE
+
+// Compressor and decompressor for the LZ4 block format, for blocks of up to
+// 64 KiB. Only what QSerialPort::Lz4Compression needs: a single fast hash
+// table pass when compressing, and bounds checked decompression of data
+// from the other end of the link.
+namespace QSerialPortLz4 {
+
+// On the wire, every block is preceded by its stored size and its
+// uncompressed size, both 16-bit little endian. A block that would not get
+// smaller is stored as it is, with both sizes equal.
+enum { HeaderSize = 4 };
+
+static_assert(QSERIALPORT_LZ4BLOCKSIZE > 0 && QSERIALPORT_LZ4BLOCKSIZE <= 0xffff,
+              "The block sizes must fit into the block header");
+
+// Compresses size bytes of src into dst. Returns the compressed size, or 0
+// if the result would not fit into capacity bytes.
+qsizetype compress(const char *src, qsizetype size, char *dst, qsizetype capacity);
+
+// Decompresses the block of size bytes at src into dst. Returns the
+// decompressed size, or -1 if the block is malformed or does not fit into
+// capacity bytes.
+qsizetype decompress(const char *src, qsizetype size, char *dst, qsizetype capacity);
+
+} // namespace QSerialPortLz4
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTLZ4_P_H
@@ -0,0 +1,460 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportreplay_p.h"
+#include "qserialportcapture_p.h"
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+
+#include <chrono>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSerialPortReplay
+    \inmodule QtSerialPort
+    \since 6.9
+
+    \brief Plays back serial port traffic recorded with QSerialPort::setCaptureDevice().
+
+    QSerialPortReplay is a sequential, read-only QIODevice that presents the
+    data a QSerialPort received while it was being recorded. Code that reads
+    from a QSerialPort through the QIODevice interface can be run against a
+    recording without any changes, which makes it possible to reproduce
+    problems seen in the field, and to benchmark parsers with real traffic.
+
+    The recording is memory-mapped, and data is copied straight from the
+    mapping into the buffer passed to read(); the device does not buffer any
+    data itself.
+
+    In the RealTime mode, which is the default, data becomes available with
+    the same timing as it was recorded, starting when the device is opened.
+    In the AsFastAsPossible mode, all data is available immediately after
+    the first readyRead() signal.
+
+    The serial port settings in effect at the time of the data that was
+    made available last can be queried with baudRate(), dataBits(),
+    parity(), stopBits() and flowControl(). Data that the application wrote
+    to the serial port while it was being recorded is skipped, and data
+    written to the replay device is discarded.
+
+    \sa QSerialPort::setCaptureDevice()
+*/
+
+/*!
+    \enum QSerialPortReplay::ReplayMode
+
+    This enum describes how fast the recorded data is made available.
+
+    \value RealTime         The data is made available with the timing it
+                            was recorded with.
+    \value AsFastAsPossible All data is made available at once.
+*/
+
+/*!
+    \fn void QSerialPortReplay::settingsChanged()
+
+    This signal is emitted when a change of the serial port settings has
+    been played back.
+*/
+
+QSerialPortReplayPrivate::QSerialPortReplayPrivate()
+{
+    // Read from the mapped file directly into the buffer of the caller
+    readBufferChunkSize = 0;
+}
+
+bool QSerialPortReplayPrivate::releaseDueRecords()
+{
+    Q_Q(QSerialPortReplay);
+    using namespace QSerialPortCapture;
+
+    const qint64 now = (replayMode == QSerialPortReplay::RealTime)
+            ? clock.nsecsElapsed() : std::numeric_limits<qint64>::max();
+    const bool wasAtEnd = releaseOffset >= mapSize;
+
+    qint64 newBytes = 0;
+    bool settingsChanged = false;
+    while (releaseOffset + RecordHeaderSize <= mapSize) {
+        const uchar *header = map + releaseOffset;
+        const qint64 size = qFromLittleEndian<quint32>(header + 4);
+        if (releaseOffset + recordSize(size) > mapSize) {
+            // The recording was cut off in the middle of a record
+            releaseOffset = mapSize;
+            break;
+        }
+        if (qFromLittleEndian<qint64>(header + 8) > now)
+            break;
+
+        switch (header[0]) {
+        case ReadRecord:
+            available += size;
+            newBytes += size;
+            break;
+        case SettingsRecord:
+            if (size >= SettingsSize) {
+                applySettings(header + RecordHeaderSize);
+                settingsChanged = true;
+            }
+            break;
+        default:
+            break;
+        }
+        releaseOffset += recordSize(size);
+    }
+    if (releaseOffset + RecordHeaderSize > mapSize)
+        releaseOffset = mapSize;
+
+    if (releaseOffset < mapSize) {
+        using namespace std::chrono;
+        const auto delay = ceil<milliseconds>(nanoseconds(nsecsUntilNextRecord()));
+        releaseTimer->start(delay);
+    }
+
+    if (settingsChanged)
+        emit q->settingsChanged();
+
+    if (newBytes > 0 && !emittedReadyRead) {
+        emittedReadyRead = true;
+        emit q->readyRead();
+        emittedReadyRead = false;
+    }
+
+    if (!wasAtEnd && releaseOffset >= mapSize)
+        emit q->readChannelFinished();
+
+    return newBytes > 0;
+}
+
+qint64 QSerialPortReplayPrivate::nsecsUntilNextRecord() const
+{
+    using namespace QSerialPortCapture;
+
+    if (replayMode != QSerialPortReplay::RealTime || releaseOffset + RecordHeaderSize > mapSize)
+        return 0;
+    const qint64 timestamp = qFromLittleEndian<qint64>(map + releaseOffset + 8);
+    return qMax(timestamp - clock.nsecsElapsed(), qint64(0));
+}
+
+void QSerialPortReplayPrivate::applySettings(const uchar *settings)
+{
+    inputBaudRate = qFromLittleEndian<qint32>(settings);
+    outputBaudRate = qFromLittleEndian<qint32>(settings + 4);
+    dataBits = QSerialPort::DataBits(settings[8]);
+    parity = QSerialPort::Parity(settings[9]);
+    stopBits = QSerialPort::StopBits(settings[10]);
+    flowControl = QSerialPort::FlowControl(settings[11]);
+}
+
+/*!
+    Constructs a new replay device with the given \a parent.
+*/
+QSerialPortReplay::QSerialPortReplay(QObject *parent)
+    : QIODevice(*new QSerialPortReplayPrivate, parent)
+{
+}
+
+/*!
+    Constructs a new replay device with the given \a parent, that plays back
+    the recording in \a fileName.
+*/
+QSerialPortReplay::QSerialPortReplay(const QString &fileName, QObject *parent)
+    : QIODevice(*new QSerialPortReplayPrivate, parent)
+{
+    setFileName(fileName);
+}
+
+/*!
+    Closes the device, if necessary, and then destroys it.
+*/
+QSerialPortReplay::~QSerialPortReplay()
+{
+    close();
+}
+
+/*!
+    Sets the \a fileName of the recording to play back. The name takes
+    effect the next time the device is opened.
+
+    \sa fileName()
+*/
+void QSerialPortReplay::setFileName(const QString &fileName)
+{
+    Q_D(QSerialPortReplay);
+    d->file.setFileName(fileName);
+}
+
+/*!
+    Returns the file name of the recording.
+
+    \sa setFileName()
+*/
+QString QSerialPortReplay::fileName() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->file.fileName();
+}
+
+/*!
+    Sets the replay \a mode. The mode takes effect the next time the device
+    is opened.
+
+    \sa replayMode()
+*/
+void QSerialPortReplay::setReplayMode(ReplayMode mode)
+{
+    Q_D(QSerialPortReplay);
+    d->replayMode = mode;
+}
+
+/*!
+    Returns the replay mode.
+
+    \sa setReplayMode()
+*/
+QSerialPortReplay::ReplayMode QSerialPortReplay::replayMode() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->replayMode;
+}
+
+/*!
+    \reimp
+
+    Maps the recording and starts to play it back. Returns \c true if
+    successful; otherwise returns \c false and sets an error string.
+
+    \note The \l{QIODeviceBase::}{Append}, \l{QIODeviceBase::}{Truncate} and
+    \l{QIODeviceBase::}{Text} modes are not supported.
+*/
+bool QSerialPortReplay::open(OpenMode mode)
+{
+    Q_D(QSerialPortReplay);
+    using namespace QSerialPortCapture;
+
+    if (isOpen()) {
+        setErrorString(tr("The device is already open"));
+        return false;
+    }
+
+    static const OpenMode unsupportedModes = Append | Truncate | Text;
+    if ((mode & unsupportedModes) || mode == NotOpen) {
+        setErrorString(tr("Unsupported open mode"));
+        return false;
+    }
+
+    if (!d->file.open(QIODevice::ReadOnly)) {
+        setErrorString(d->file.errorString());
+        return false;
+    }
+
+    d->mapSize = d->file.size();
+    d->map = d->mapSize >= FileHeaderSize ? d->file.map(0, d->mapSize) : nullptr;
+    if (!d->map
+            || ::memcmp(d->map, Magic, sizeof(Magic)) != 0
+            || qFromLittleEndian<quint16>(d->map + sizeof(Magic)) != Version) {
+        setErrorString(tr("Not a serial port capture file"));
+        d->file.close();
+        d->map = nullptr;
+        d->mapSize = 0;
+        return false;
+    }
+
+    d->releaseOffset = FileHeaderSize;
+    d->readOffset = FileHeaderSize;
+    d->readPayloadOffset = 0;
+    d->available = 0;
+
+    if (!d->releaseTimer) {
+        d->releaseTimer = new QTimer(this);
+        d->releaseTimer->setSingleShot(true);
+        d->releaseTimer->setTimerType(Qt::PreciseTimer);
+        connect(d->releaseTimer, &QTimer::timeout, this, [d]() {
+            d->releaseDueRecords();
+        });
+    }
+    d->clock.start();
+    d->releaseTimer->start(0);
+
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+*/
+void QSerialPortReplay::close()
+{
+    Q_D(QSerialPortReplay);
+
+    if (!isOpen())
+        return;
+
+    QIODevice::close();
+    d->releaseTimer->stop();
+    d->file.unmap(const_cast<uchar *>(d->map));
+    d->file.close();
+    d->map = nullptr;
+    d->mapSize = 0;
+    d->available = 0;
+}
+
+/*!
+    Returns the baud rate for the given \a directions in effect for the data
+    that was made available last.
+
+    \sa QSerialPort::baudRate
+*/
+qint32 QSerialPortReplay::baudRate(QSerialPort::Directions directions) const
+{
+    Q_D(const QSerialPortReplay);
+    if (directions == QSerialPort::AllDirections)
+        return d->inputBaudRate == d->outputBaudRate ? d->inputBaudRate : -1;
+    return directions & QSerialPort::Input ? d->inputBaudRate : d->outputBaudRate;
+}
+
+/*!
+    Returns the data bits in effect for the data that was made available
+    last.
+*/
+QSerialPort::DataBits QSerialPortReplay::dataBits() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->dataBits;
+}
+
+/*!
+    Returns the parity in effect for the data that was made available last.
+*/
+QSerialPort::Parity QSerialPortReplay::parity() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->parity;
+}
+
+/*!
+    Returns the stop bits in effect for the data that was made available
+    last.
+*/
+QSerialPort::StopBits QSerialPortReplay::stopBits() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->stopBits;
+}
+
+/*!
+    Returns the flow control in effect for the data that was made available
+    last.
+*/
+QSerialPort::FlowControl QSerialPortReplay::flowControl() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->flowControl;
+}
+
+/*!
+    \reimp
+
+    Always returns \c true. The replay device is a sequential device.
+*/
+bool QSerialPortReplay::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+
+    Returns \c true if the whole recording has been played back and read.
+*/
+bool QSerialPortReplay::atEnd() const
+{
+    Q_D(const QSerialPortReplay);
+    return !isOpen() || (d->releaseOffset >= d->mapSize && bytesAvailable() == 0);
+}
+
+/*!
+    \reimp
+*/
+qint64 QSerialPortReplay::bytesAvailable() const
+{
+    Q_D(const QSerialPortReplay);
+    return d->available + QIODevice::bytesAvailable();
+}
+
+/*!
+    \reimp
+
+    Waits until more recorded data becomes available, or \a msecs
+    milliseconds have passed. If \a msecs is -1, this function will not
+    time out. Returns \c false if the timeout expired or the end of the
+    recording was reached.
+*/
+bool QSerialPortReplay::waitForReadyRead(int msecs)
+{
+    Q_D(QSerialPortReplay);
+
+    if (!isOpen())
+        return false;
+
+    const QDeadlineTimer deadline(msecs);
+    while (d->releaseOffset < d->mapSize) {
+        const qint64 wait = d->nsecsUntilNextRecord();
+        if (wait > 0) {
+            const qint64 remaining = deadline.remainingTimeNSecs();
+            if (remaining >= 0 && remaining < wait) {
+                QThread::sleep(std::chrono::nanoseconds(remaining));
+                return false;
+            }
+            QThread::sleep(std::chrono::nanoseconds(wait));
+        }
+        if (d->releaseDueRecords())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \reimp
+*/
+qint64 QSerialPortReplay::readData(char *data, qint64 maxSize)
+{
+    Q_D(QSerialPortReplay);
+    using namespace QSerialPortCapture;
+
+    qint64 readBytes = 0;
+    while (readBytes < maxSize && d->available > 0) {
+        const uchar *header = d->map + d->readOffset;
+        const qint64 size = qFromLittleEndian<quint32>(header + 4);
+        if (header[0] == ReadRecord) {
+            const qint64 chunk = qMin(size - d->readPayloadOffset, maxSize - readBytes);
+            ::memcpy(data + readBytes, header + RecordHeaderSize + d->readPayloadOffset, chunk);
+            readBytes += chunk;
+            d->readPayloadOffset += chunk;
+            d->available -= chunk;
+            if (d->readPayloadOffset < size)
+                break;
+        }
+        d->readOffset += recordSize(size);
+        d->readPayloadOffset = 0;
+    }
+    return readBytes;
+}
+
+/*!
+    \reimp
+
+    Discards \a data and returns \a maxSize.
+*/
+qint64 QSerialPortReplay::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    return maxSize;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qserialportreplay.cpp"
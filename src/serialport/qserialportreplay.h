@@ -0,0 +1,65 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTREPLAY_H
+#define QSERIALPORTREPLAY_H
+
+#include <QtCore/qiodevice.h>
+
+#include <QtSerialPort/qserialport.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSerialPortReplayPrivate;
+
+class Q_SERIALPORT_EXPORT QSerialPortReplay : public QIODevice
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QSerialPortReplay)
+
+public:
+    enum ReplayMode {
+        RealTime,
+        AsFastAsPossible
+    };
+    Q_ENUM(ReplayMode)
+
+    explicit QSerialPortReplay(QObject *parent = nullptr);
+    explicit QSerialPortReplay(const QString &fileName, QObject *parent = nullptr);
+    ~QSerialPortReplay() override;
+
+    void setFileName(const QString &fileName);
+    QString fileName() const;
+
+    void setReplayMode(ReplayMode mode);
+    ReplayMode replayMode() const;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    qint32 baudRate(QSerialPort::Directions directions = QSerialPort::AllDirections) const;
+    QSerialPort::DataBits dataBits() const;
+    QSerialPort::Parity parity() const;
+    QSerialPort::StopBits stopBits() const;
+    QSerialPort::FlowControl flowControl() const;
+
+    bool isSequential() const override;
+    bool atEnd() const override;
+    qint64 bytesAvailable() const override;
+
+    bool waitForReadyRead(int msecs = 30000) override;
+
+Q_SIGNALS:
+    void settingsChanged();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    Q_DISABLE_COPY(QSerialPortReplay)
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTREPLAY_H
@@ -0,0 +1,69 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTREPLAY_P_H
+#define QSERIALPORTREPLAY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialportreplay.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+
+#include <private/qiodevice_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QTimer;
+
+class QSerialPortReplayPrivate : public QIODevicePrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QSerialPortReplay)
+
+    QSerialPortReplayPrivate();
+
+    bool releaseDueRecords();
+    qint64 nsecsUntilNextRecord() const;
+    void applySettings(const uchar *settings);
+
+    QFile file;
+    QSerialPortReplay::ReplayMode replayMode = QSerialPortReplay::RealTime;
+
+    const uchar *map = nullptr;
+    qint64 mapSize = 0;
+
+    // Offset of the first record that is not due yet
+    qint64 releaseOffset = 0;
+    // Offset of the record being read, and how much of its payload was read
+    qint64 readOffset = 0;
+    qint64 readPayloadOffset = 0;
+    // Payload bytes of due records not read yet
+    qint64 available = 0;
+
+    QElapsedTimer clock;
+    QTimer *releaseTimer = nullptr;
+
+    qint32 inputBaudRate = QSerialPort::Baud9600;
+    qint32 outputBaudRate = QSerialPort::Baud9600;
+    QSerialPort::DataBits dataBits = QSerialPort::Data8;
+    QSerialPort::Parity parity = QSerialPort::NoParity;
+    QSerialPort::StopBits stopBits = QSerialPort::OneStop;
+    QSerialPort::FlowControl flowControl = QSerialPort::NoFlowControl;
+
+    bool emittedReadyRead = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTREPLAY_P_H
@@ -0,0 +1,729 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qserialportrfc2217_p.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum TelnetCommand : quint8 {
+    SE = 240,
+    SB = 250,
+    WILL = 251,
+    WONT = 252,
+    DO = 253,
+    DONT = 254,
+    IAC = 255
+};
+
+enum TelnetOption : quint8 {
+    BinaryOption = 0,
+    SuppressGoAheadOption = 3,
+    ComPortOption = 44
+};
+
+// Client to server COM-PORT-OPTION commands. The server answers with the
+// command code plus ServerCommandOffset.
+enum ComPortCommand : quint8 {
+    SetBaudRateCommand = 1,
+    SetDataSizeCommand = 2,
+    SetParityCommand = 3,
+    SetStopSizeCommand = 4,
+    SetControlCommand = 5,
+    NotifyModemStateCommand = 7,
+    PurgeDataCommand = 12,
+    ServerCommandOffset = 100
+};
+
+// None of the COM-PORT-OPTION commands comes near it
+enum { MaxSubnegotiationSize = 256 };
+
+enum ComPortControl : quint8 {
+    NoFlowControlValue = 1,
+    SoftwareFlowControlValue = 2,
+    HardwareFlowControlValue = 3,
+    BreakOnValue = 5,
+    BreakOffValue = 6,
+    DtrOnValue = 8,
+    DtrOffValue = 9,
+    RtsOnValue = 11,
+    RtsOffValue = 12
+};
+
+enum ComPortModemState : quint8 {
+    CtsState = 0x10,
+    DsrState = 0x20,
+    RiState = 0x40,
+    CdState = 0x80
+};
+
+enum {
+    DefaultTelnetPort = 23,
+    ConnectTimeout = 30000,
+    ReceiveChunkSize = 16384,
+    // write() takes no more data while this much is not sent yet
+    OutboundLimit = 65536,
+    MaxSendBlocks = 16
+};
+
+bool isLocalOption(quint8 option)
+{
+    return option == BinaryOption || option == SuppressGoAheadOption || option == ComPortOption;
+}
+
+bool isRemoteOption(quint8 option)
+{
+    return option == BinaryOption || option == SuppressGoAheadOption;
+}
+
+} // namespace
+
+QSerialPortRfc2217Backend::QSerialPortRfc2217Backend(const QString &location)
+{
+    // "host", "host:port" or "[address]:port"
+    QString name = location;
+    if (name.endsWith(u'/'))
+        name.chop(1);
+
+    qsizetype portSeparator = name.lastIndexOf(u':');
+    if (name.startsWith(u'[')) {
+        const qsizetype end = name.indexOf(u']');
+        if (end < 0 || (portSeparator >= 0 && portSeparator < end))
+            portSeparator = -1;
+        host = name.mid(1, end - 1);
+        if (portSeparator < 0 && end + 1 != name.size())
+            host.clear();
+    } else if (portSeparator >= 0 && name.indexOf(u':') != portSeparator) {
+        // A bare IPv6 address without a port
+        portSeparator = -1;
+        host = name;
+    } else {
+        host = name.left(portSeparator);
+    }
+
+    if (portSeparator >= 0) {
+        bool ok = false;
+        port = name.mid(portSeparator + 1).toUShort(&ok);
+        if (!ok || port == 0)
+            host.clear();
+    }
+}
+
+QSerialPortRfc2217Backend::~QSerialPortRfc2217Backend()
+{
+    close();
+}
+
+bool QSerialPortRfc2217Backend::open(QIODevice::OpenMode mode)
+{
+    Q_UNUSED(mode);
+
+    if (host.isEmpty()) {
+        setError(QSerialPort::DeviceNotFoundError,
+                 QSerialPort::tr("Invalid network serial port location"));
+        return false;
+    }
+    if (!connectToServer())
+        return false;
+
+    sendOption(WILL, BinaryOption);
+    sendOption(DO, BinaryOption);
+    sendOption(WILL, SuppressGoAheadOption);
+    sendOption(DO, SuppressGoAheadOption);
+    sendOption(WILL, ComPortOption);
+    localOptions = (1ULL << BinaryOption) | (1ULL << SuppressGoAheadOption)
+            | (1ULL << ComPortOption);
+    remoteOptions = (1ULL << BinaryOption) | (1ULL << SuppressGoAheadOption);
+    return true;
+}
+
+void QSerialPortRfc2217Backend::close()
+{
+    if (descriptor == -1)
+        return;
+
+    // The notifiers may be the ones currently delivering an event
+    readNotifier->setEnabled(false);
+    readNotifier->deleteLater();
+    readNotifier = nullptr;
+    writeNotifier->setEnabled(false);
+    writeNotifier->deleteLater();
+    writeNotifier = nullptr;
+    qt_safe_close(descriptor);
+    descriptor = -1;
+
+    outbound.clear();
+    parserState = DataState;
+    subnegotiation.clear();
+    subnegotiationOverflow = false;
+    modemState = 0;
+}
+
+qint64 QSerialPortRfc2217Backend::read(char *data, qint64 maxSize)
+{
+    return inbound.read(data, maxSize);
+}
+
+qint64 QSerialPortRfc2217Backend::write(const char *data, qint64 maxSize)
+{
+    if (descriptor == -1)
+        return -1;
+
+    if (outbound.size() >= OutboundLimit) {
+        writeBlocked = true;
+        return 0;
+    }
+
+    // Double the IAC bytes, the rest of the data goes through unchanged
+    const char *ptr = data;
+    const char *end = data + maxSize;
+    while (ptr < end) {
+        const char *iac = static_cast<const char *>(::memchr(ptr, IAC, end - ptr));
+        if (!iac) {
+            outbound.append(ptr, end - ptr);
+            break;
+        }
+        outbound.append(ptr, iac - ptr + 1);
+        outbound.putChar(char(IAC));
+        ptr = iac + 1;
+    }
+
+    if (!writeNotification())
+        return -1;
+    return maxSize;
+}
+
+bool QSerialPortRfc2217Backend::waitForReadyRead(QDeadlineTimer deadline)
+{
+    while (inbound.isEmpty()) {
+        bool readyToRead = false;
+        bool readyToWrite = false;
+        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, deadline))
+            return false;
+        if (readyToWrite && !writeNotification())
+            return false;
+        if (readyToRead && !readNotification())
+            return false;
+    }
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::waitForWritable(QDeadlineTimer deadline)
+{
+    while (outbound.size() >= OutboundLimit) {
+        bool readyToRead = false;
+        bool readyToWrite = false;
+        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, deadline))
+            return false;
+        if (readyToWrite && !writeNotification())
+            return false;
+        if (readyToRead && !readNotification())
+            return false;
+    }
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::setBaudRate(qint32 baudRate, QSerialPort::Directions directions)
+{
+    // The device server has one rate for both directions
+    if (!(directions & QSerialPort::Output))
+        return true;
+
+    const quint32 value = qToBigEndian(quint32(baudRate));
+    return sendCommand(SetBaudRateCommand, reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+bool QSerialPortRfc2217Backend::setDataBits(QSerialPort::DataBits dataBits)
+{
+    return sendCommand(SetDataSizeCommand, quint8(dataBits));
+}
+
+bool QSerialPortRfc2217Backend::setParity(QSerialPort::Parity parity)
+{
+    quint8 value;
+    switch (parity) {
+    case QSerialPort::NoParity:
+        value = 1;
+        break;
+    case QSerialPort::OddParity:
+        value = 2;
+        break;
+    case QSerialPort::EvenParity:
+        value = 3;
+        break;
+    case QSerialPort::MarkParity:
+        value = 4;
+        break;
+    case QSerialPort::SpaceParity:
+        value = 5;
+        break;
+    default:
+        setError(QSerialPort::UnsupportedOperationError,
+                 QSerialPort::tr("Unsupported parity"));
+        return false;
+    }
+    return sendCommand(SetParityCommand, value);
+}
+
+bool QSerialPortRfc2217Backend::setStopBits(QSerialPort::StopBits stopBits)
+{
+    quint8 value;
+    switch (stopBits) {
+    case QSerialPort::OneStop:
+        value = 1;
+        break;
+    case QSerialPort::TwoStop:
+        value = 2;
+        break;
+    case QSerialPort::OneAndHalfStop:
+        value = 3;
+        break;
+    default:
+        setError(QSerialPort::UnsupportedOperationError,
+                 QSerialPort::tr("Unsupported stop bits"));
+        return false;
+    }
+    return sendCommand(SetStopSizeCommand, value);
+}
+
+bool QSerialPortRfc2217Backend::setFlowControl(QSerialPort::FlowControl flowControl)
+{
+    quint8 value;
+    switch (flowControl) {
+    case QSerialPort::NoFlowControl:
+        value = NoFlowControlValue;
+        break;
+    case QSerialPort::SoftwareControl:
+        value = SoftwareFlowControlValue;
+        break;
+    case QSerialPort::HardwareControl:
+        value = HardwareFlowControlValue;
+        break;
+    default:
+        setError(QSerialPort::UnsupportedOperationError,
+                 QSerialPort::tr("Unsupported flow control"));
+        return false;
+    }
+    return sendCommand(SetControlCommand, value);
+}
+
+QSerialPort::PinoutSignals QSerialPortRfc2217Backend::pinoutSignals()
+{
+    QSerialPort::PinoutSignals pinout;
+
+    if (dataTerminalReady)
+        pinout |= QSerialPort::DataTerminalReadySignal;
+    if (requestToSend)
+        pinout |= QSerialPort::RequestToSendSignal;
+    if (modemState & CtsState)
+        pinout |= QSerialPort::ClearToSendSignal;
+    if (modemState & DsrState)
+        pinout |= QSerialPort::DataSetReadySignal;
+    if (modemState & RiState)
+        pinout |= QSerialPort::RingIndicatorSignal;
+    if (modemState & CdState)
+        pinout |= QSerialPort::DataCarrierDetectSignal;
+
+    return pinout;
+}
+
+bool QSerialPortRfc2217Backend::setDataTerminalReady(bool set)
+{
+    if (!sendCommand(SetControlCommand, set ? DtrOnValue : DtrOffValue))
+        return false;
+    dataTerminalReady = set;
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::setRequestToSend(bool set)
+{
+    if (!sendCommand(SetControlCommand, set ? RtsOnValue : RtsOffValue))
+        return false;
+    requestToSend = set;
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::setBreakEnabled(bool set)
+{
+    return sendCommand(SetControlCommand, set ? BreakOnValue : BreakOffValue);
+}
+
+bool QSerialPortRfc2217Backend::flush()
+{
+    return writeNotification();
+}
+
+bool QSerialPortRfc2217Backend::clear(QSerialPort::Directions directions)
+{
+    // 1 purges the data received by the device server, 2 its transmit data
+    quint8 value = 0;
+    if (directions & QSerialPort::Input) {
+        inbound.clear();
+        value |= 1;
+    }
+    if (directions & QSerialPort::Output)
+        value |= 2;
+    return value == 0 || sendCommand(PurgeDataCommand, value);
+}
+
+bool QSerialPortRfc2217Backend::connectToServer()
+{
+    addrinfo hints;
+    ::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    addrinfo *addresses = nullptr;
+    const int result = ::getaddrinfo(host.toUtf8().constData(),
+                                     QByteArray::number(port).constData(),
+                                     &hints, &addresses);
+    if (result != 0) {
+        setError(QSerialPort::DeviceNotFoundError,
+                 QString::fromLocal8Bit(::gai_strerror(result)));
+        return false;
+    }
+
+    const QDeadlineTimer deadline(ConnectTimeout);
+    int errorCode = ETIMEDOUT;
+    for (addrinfo *address = addresses; address && descriptor == -1; address = address->ai_next) {
+        const int socket = ::socket(address->ai_family, address->ai_socktype,
+                                    address->ai_protocol);
+        if (socket == -1) {
+            errorCode = errno;
+            continue;
+        }
+        ::fcntl(socket, F_SETFD, FD_CLOEXEC);
+        ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+        int connected;
+        do {
+            connected = ::connect(socket, address->ai_addr, address->ai_addrlen);
+        } while (connected == -1 && errno == EINTR);
+
+        if (connected == -1 && errno == EINPROGRESS) {
+            pollfd pfd = qt_make_pollfd(socket, POLLOUT);
+            const int ret = qt_safe_poll(&pfd, 1, deadline);
+            if (ret > 0) {
+                socklen_t length = sizeof(errorCode);
+                ::getsockopt(socket, SOL_SOCKET, SO_ERROR, &errorCode, &length);
+                connected = errorCode == 0 ? 0 : -1;
+            } else {
+                errorCode = ret == 0 ? ETIMEDOUT : errno;
+            }
+        } else if (connected == -1) {
+            errorCode = errno;
+        }
+
+        if (connected == -1) {
+            qt_safe_close(socket);
+            if (deadline.hasExpired())
+                break;
+            continue;
+        }
+        descriptor = socket;
+    }
+    ::freeaddrinfo(addresses);
+
+    if (descriptor == -1) {
+        setError(errorCode == ECONNREFUSED || errorCode == EHOSTUNREACH
+                         || errorCode == ENETUNREACH
+                     ? QSerialPort::DeviceNotFoundError : QSerialPort::OpenError,
+                 qt_error_string(errorCode));
+        return false;
+    }
+
+    // Telnet commands and single characters go out without waiting for
+    // more data; the writes are batched in the outbound buffer instead.
+    const int noDelay = 1;
+    ::setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    readNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Read);
+    QObject::connect(readNotifier, &QSocketNotifier::activated, readNotifier, [this]() {
+        readNotification();
+    });
+    writeNotifier = new QSocketNotifier(descriptor, QSocketNotifier::Write);
+    writeNotifier->setEnabled(false);
+    QObject::connect(writeNotifier, &QSocketNotifier::activated, writeNotifier, [this]() {
+        writeNotification();
+    });
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::readNotification()
+{
+    char data[ReceiveChunkSize];
+    const qint64 readBytes = qt_safe_read(descriptor, data, sizeof(data));
+
+    if (readBytes < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return true;
+        connectionLost(qt_error_string(errno));
+        return false;
+    }
+    if (readBytes == 0) {
+        connectionLost(QSerialPort::tr("The device server closed the connection"));
+        return false;
+    }
+
+    const bool wasEmpty = inbound.isEmpty();
+    parse(data, readBytes);
+    if (wasEmpty && !inbound.isEmpty())
+        readyRead();
+
+    // Answers to the options of the server
+    if (!outbound.isEmpty())
+        writeNotifier->setEnabled(true);
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::writeNotification()
+{
+    if (descriptor == -1)
+        return false;
+
+    // Hand all pending data to the socket at once
+    while (!outbound.isEmpty()) {
+        QVarLengthArray<iovec, MaxSendBlocks> blocks;
+        qint64 position = 0;
+        while (blocks.size() < MaxSendBlocks && position < outbound.size()) {
+            qint64 length = 0;
+            const char *block = outbound.readPointerAtPosition(position, length);
+            blocks.append({ const_cast<char *>(block), size_t(length) });
+            position += length;
+        }
+
+        msghdr message;
+        ::memset(&message, 0, sizeof(message));
+        message.msg_iov = blocks.data();
+        message.msg_iovlen = blocks.size();
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        flags |= MSG_NOSIGNAL;
+#endif
+        qint64 sent;
+        do {
+            sent = ::sendmsg(descriptor, &message, flags);
+        } while (sent == -1 && errno == EINTR);
+
+        if (sent == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            connectionLost(qt_error_string(errno));
+            return false;
+        }
+        outbound.free(sent);
+    }
+
+    writeNotifier->setEnabled(!outbound.isEmpty());
+    if (writeBlocked && outbound.size() < OutboundLimit) {
+        writeBlocked = false;
+        readyWrite();
+    }
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::waitForReadOrWrite(bool *selectForRead, bool *selectForWrite,
+                                                   QDeadlineTimer deadline)
+{
+    if (descriptor == -1)
+        return false;
+
+    pollfd pfd = qt_make_pollfd(descriptor, POLLIN);
+    if (!outbound.isEmpty())
+        pfd.events |= POLLOUT;
+
+    const int ret = qt_safe_poll(&pfd, 1, deadline);
+    if (ret <= 0)
+        return false;
+
+    *selectForRead = (pfd.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+    *selectForWrite = (pfd.revents & POLLOUT) != 0;
+    return true;
+}
+
+void QSerialPortRfc2217Backend::parse(const char *data, qint64 size)
+{
+    const char *ptr = data;
+    const char *end = data + size;
+
+    while (ptr < end) {
+        if (parserState == DataState) {
+            const char *iac = static_cast<const char *>(::memchr(ptr, IAC, end - ptr));
+            if (!iac) {
+                inbound.append(ptr, end - ptr);
+                break;
+            }
+            inbound.append(ptr, iac - ptr);
+            parserState = CommandState;
+            ptr = iac + 1;
+            continue;
+        }
+
+        const quint8 byte = quint8(*ptr++);
+        switch (parserState) {
+        case DataState:
+            break;
+        case CommandState:
+            if (byte == IAC) {
+                inbound.putChar(char(IAC));
+                parserState = DataState;
+            } else if (byte >= WILL && byte <= DONT) {
+                optionVerb = byte;
+                parserState = OptionState;
+            } else if (byte == SB) {
+                subnegotiation.clear();
+                subnegotiationOverflow = false;
+                parserState = SubnegotiationState;
+            } else {
+                // NOP, GA and the other commands have no meaning here
+                parserState = DataState;
+            }
+            break;
+        case OptionState:
+            handleOption(optionVerb, byte);
+            parserState = DataState;
+            break;
+        case SubnegotiationState:
+            if (byte == IAC)
+                parserState = SubnegotiationCommandState;
+            else
+                appendSubnegotiation(byte);
+            break;
+        case SubnegotiationCommandState:
+            if (byte == SE) {
+                if (!subnegotiationOverflow)
+                    handleSubnegotiation();
+                parserState = DataState;
+            } else {
+                appendSubnegotiation(byte);
+                parserState = SubnegotiationState;
+            }
+            break;
+        }
+    }
+}
+
+void QSerialPortRfc2217Backend::handleOption(quint8 verb, quint8 option)
+{
+    const quint64 bit = option < 64 ? (1ULL << option) : 0;
+
+    // Only answer requests that change the state of an option, so that
+    // the negotiation can not loop. A refused option stays disabled.
+    switch (verb) {
+    case DO:
+        if (!isLocalOption(option)) {
+            sendOption(WONT, option);
+        } else {
+            if (!(localOptions & bit))
+                sendOption(WILL, option);
+            localOptions |= bit;
+        }
+        break;
+    case DONT:
+        if (localOptions & bit)
+            sendOption(WONT, option);
+        localOptions &= ~bit;
+        break;
+    case WILL:
+        if (!isRemoteOption(option)) {
+            sendOption(DONT, option);
+        } else {
+            if (!(remoteOptions & bit))
+                sendOption(DO, option);
+            remoteOptions |= bit;
+        }
+        break;
+    case WONT:
+        if (remoteOptions & bit)
+            sendOption(DONT, option);
+        remoteOptions &= ~bit;
+        break;
+    }
+}
+
+void QSerialPortRfc2217Backend::appendSubnegotiation(quint8 byte)
+{
+    // A server sending endless subnegotiation data must not exhaust memory
+    if (subnegotiation.size() < MaxSubnegotiationSize)
+        subnegotiation.append(char(byte));
+    else
+        subnegotiationOverflow = true;
+}
+
+void QSerialPortRfc2217Backend::handleSubnegotiation()
+{
+    if (subnegotiation.size() < 2 || quint8(subnegotiation.at(0)) != ComPortOption)
+        return;
+
+    const quint8 command = quint8(subnegotiation.at(1));
+    if (command == ServerCommandOffset + NotifyModemStateCommand && subnegotiation.size() >= 3)
+        modemState = quint8(subnegotiation.at(2));
+}
+
+void QSerialPortRfc2217Backend::sendOption(quint8 verb, quint8 option)
+{
+    const char command[] = { char(IAC), char(verb), char(option) };
+    outbound.append(command, sizeof(command));
+    if (writeNotifier)
+        writeNotifier->setEnabled(true);
+}
+
+bool QSerialPortRfc2217Backend::sendCommand(quint8 command, const char *value, qint64 size)
+{
+    if (descriptor == -1) {
+        setError(QSerialPort::ResourceError,
+                 QSerialPort::tr("The device server closed the connection"));
+        return false;
+    }
+
+    const char header[] = { char(IAC), char(SB), char(ComPortOption), char(command) };
+    outbound.append(header, sizeof(header));
+    for (qint64 i = 0; i < size; ++i) {
+        outbound.putChar(value[i]);
+        if (quint8(value[i]) == IAC)
+            outbound.putChar(char(IAC));
+    }
+    const char trailer[] = { char(IAC), char(SE) };
+    outbound.append(trailer, sizeof(trailer));
+
+    // Sent with the next write or once the event loop runs, so that a
+    // series of settings goes out in one segment
+    writeNotifier->setEnabled(true);
+    return true;
+}
+
+bool QSerialPortRfc2217Backend::sendCommand(quint8 command, quint8 value)
+{
+    const char data = char(value);
+    return sendCommand(command, &data, 1);
+}
+
+void QSerialPortRfc2217Backend::connectionLost(const QString &errorString)
+{
+    close();
+    // May destroy this backend if the port is closed in response
+    setError(QSerialPort::ResourceError, errorString);
+}
+
+QT_END_NAMESPACE
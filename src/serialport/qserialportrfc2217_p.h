@@ -0,0 +1,106 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSERIALPORTRFC2217_P_H
+#define QSERIALPORTRFC2217_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qserialportbackend_p.h"
+
+#include <private/qringbuffer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+// Serial port on a network device server, controlled with the Telnet
+// COM-PORT-OPTION of RFC 2217. Selected by port names of the form
+// "rfc2217://host:port".
+class QSerialPortRfc2217Backend final : public QSerialPortBackend
+{
+public:
+    explicit QSerialPortRfc2217Backend(const QString &location);
+    ~QSerialPortRfc2217Backend() override;
+
+    bool open(QIODevice::OpenMode mode) override;
+    void close() override;
+
+    qint64 read(char *data, qint64 maxSize) override;
+    qint64 write(const char *data, qint64 maxSize) override;
+
+    bool waitForReadyRead(QDeadlineTimer deadline) override;
+    bool waitForWritable(QDeadlineTimer deadline) override;
+
+    bool setBaudRate(qint32 baudRate, QSerialPort::Directions directions) override;
+    bool setDataBits(QSerialPort::DataBits dataBits) override;
+    bool setParity(QSerialPort::Parity parity) override;
+    bool setStopBits(QSerialPort::StopBits stopBits) override;
+    bool setFlowControl(QSerialPort::FlowControl flowControl) override;
+
+    QSerialPort::PinoutSignals pinoutSignals() override;
+    bool setDataTerminalReady(bool set) override;
+    bool setRequestToSend(bool set) override;
+    bool setBreakEnabled(bool set) override;
+
+    bool flush() override;
+    bool clear(QSerialPort::Directions directions) override;
+
+private:
+    enum ParserState {
+        DataState,
+        CommandState,
+        OptionState,
+        SubnegotiationState,
+        SubnegotiationCommandState
+    };
+
+    bool connectToServer();
+    bool readNotification();
+    bool writeNotification();
+    bool waitForReadOrWrite(bool *selectForRead, bool *selectForWrite, QDeadlineTimer deadline);
+    void parse(const char *data, qint64 size);
+    void handleOption(quint8 verb, quint8 option);
+    void appendSubnegotiation(quint8 byte);
+    void handleSubnegotiation();
+    void sendOption(quint8 verb, quint8 option);
+    bool sendCommand(quint8 command, const char *value, qint64 size);
+    bool sendCommand(quint8 command, quint8 value);
+    void connectionLost(const QString &errorString);
+
+    QString host;
+    quint16 port = 23;
+    int descriptor = -1;
+    QSocketNotifier *readNotifier = nullptr;
+    QSocketNotifier *writeNotifier = nullptr;
+
+    QRingBuffer inbound;  // received serial data, Telnet decoded
+    QRingBuffer outbound; // Telnet encoded data and commands not sent yet
+
+    ParserState parserState = DataState;
+    quint8 optionVerb = 0;
+    QByteArray subnegotiation;
+    // The subnegotiation exceeded MaxSubnegotiationSize and is dropped
+    bool subnegotiationOverflow = false;
+    // Telnet options enabled on our side and on the server side
+    quint64 localOptions = 0;
+    quint64 remoteOptions = 0;
+    bool writeBlocked = false;
+
+    quint8 modemState = 0;
+    bool dataTerminalReady = false;
+    bool requestToSend = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSERIALPORTRFC2217_P_H
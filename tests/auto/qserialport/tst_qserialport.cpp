@@ -5,6 +5,11 @@
 #include <QtTest/private/qpropertytesthelper_p.h>
 #include <QtSerialPort/QSerialPort>
 #include <QtSerialPort/QSerialPortInfo>
+#include <QtSerialPort/QSerialPortReplay>
+#include <QtSerialPort/QSerialPortFilter>
+#ifdef Q_OS_UNIX
+#include <QtSerialPort/QSerialPortBroker>
+#endif
 
 #include <QThread>
 
@@ -14,6 +19,7 @@ Q_DECLARE_METATYPE(QSerialPort::DataBits);
 Q_DECLARE_METATYPE(QSerialPort::Parity);
 Q_DECLARE_METATYPE(QSerialPort::StopBits);
 Q_DECLARE_METATYPE(QSerialPort::FlowControl);
+Q_DECLARE_METATYPE(QSerialPort::WriteBufferPolicy);
 Q_DECLARE_METATYPE(QIODevice::OpenMode);
 Q_DECLARE_METATYPE(QIODevice::OpenModeFlag);
 Q_DECLARE_METATYPE(Qt::ConnectionType);
@@ -80,6 +86,29 @@ private slots:
     void doubleFlush();
 
     void waitForBytesWritten();
+    void immediateWrite();
+    void limitedWriteBuffer_data();
+    void limitedWriteBuffer();
+    void readBufferWatermarks();
+    void readChunk();
+    void brokerFanOut();
+    void captureAndReplay();
+    void loopbackBackend();
+    void openAll();
+    void ioThread();
+    void dataHandler();
+    void framing_data();
+    void framing();
+    void frameCheck();
+    void filters();
+    void compression();
+    void compressionWithLimitedWriteBuffer_data();
+    void compressionWithLimitedWriteBuffer();
+    void blockingMode();
+    void transmitComplete();
+    void driverQueueSizes();
+    void lineErrorReporting();
+    void nineBitMode();
 
     void waitForReadyReadWithTimeout();
     void waitForReadyReadWithOneByte();
@@ -664,6 +693,698 @@ void tst_QSerialPort::waitForBytesWritten()
     QVERIFY(toWrite > serialPort.bytesToWrite());
 }
 
+void tst_QSerialPort::immediateWrite()
+{
+    // the dummy device on other side also has to be open
+    QSerialPort dummySerialPort(m_receiverPortName);
+    QVERIFY(dummySerialPort.open(QIODevice::ReadOnly));
+
+    QSerialPort serialPort(m_senderPortName);
+    QVERIFY(!serialPort.isImmediateWriteEnabled());
+    serialPort.setImmediateWriteEnabled(true);
+    QVERIFY(serialPort.isImmediateWriteEnabled());
+    QSignalSpy bytesWrittenSpy(&serialPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+
+    QVERIFY(serialPort.open(QIODevice::WriteOnly));
+    QCOMPARE(serialPort.write(alphabetArray), qint64(alphabetArray.size()));
+#ifndef Q_OS_WIN
+    // the data is passed to the driver without waiting for the event loop
+    QCOMPARE(serialPort.bytesToWrite(), qint64(0));
+#endif
+    // but the signal is still emitted asynchronously
+    QCOMPARE(bytesWrittenSpy.size(), 0);
+    QVERIFY(serialPort.waitForBytesWritten(1000));
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), qint64(alphabetArray.size()));
+}
+
+void tst_QSerialPort::limitedWriteBuffer_data()
+{
+    QTest::addColumn<QSerialPort::WriteBufferPolicy>("policy");
+    QTest::addColumn<qint64>("expectedWritten");
+
+    const qint64 maxSize = 4;
+    QTest::newRow("RejectWhenFull") << QSerialPort::RejectWhenFull << maxSize;
+    QTest::newRow("DropOldestWhenFull") << QSerialPort::DropOldestWhenFull
+                                        << qint64(alphabetArray.size());
+}
+
+void tst_QSerialPort::limitedWriteBuffer()
+{
+    QFETCH(QSerialPort::WriteBufferPolicy, policy);
+    QFETCH(qint64, expectedWritten);
+
+    // the dummy device on other side also has to be open
+    QSerialPort dummySerialPort(m_receiverPortName);
+    QVERIFY(dummySerialPort.open(QIODevice::ReadOnly));
+
+    QSerialPort serialPort(m_senderPortName);
+    QCOMPARE(serialPort.writeBufferMaxSize(), qint64(0));
+    serialPort.setWriteBufferMaxSize(4);
+    QCOMPARE(serialPort.writeBufferMaxSize(), qint64(4));
+    serialPort.setWriteBufferPolicy(policy);
+    QCOMPARE(serialPort.writeBufferPolicy(), policy);
+
+    QSignalSpy fullSpy(&serialPort, &QSerialPort::writeBufferFull);
+    QVERIFY(fullSpy.isValid());
+    QSignalSpy drainedSpy(&serialPort, &QSerialPort::writeBufferDrained);
+    QVERIFY(drainedSpy.isValid());
+
+    QVERIFY(serialPort.open(QIODevice::WriteOnly));
+    QCOMPARE(serialPort.write(alphabetArray), expectedWritten);
+    QCOMPARE(serialPort.bytesToWrite(), qint64(4));
+    QCOMPARE(fullSpy.size(), 1);
+    QCOMPARE(drainedSpy.size(), 0);
+
+    QVERIFY(serialPort.waitForBytesWritten(1000));
+    QCOMPARE(drainedSpy.size(), 1);
+}
+
+void tst_QSerialPort::readBufferWatermarks()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QCOMPARE(receiverPort.readBufferHighWatermark(), qint64(0));
+    receiverPort.setReadBufferWatermarks(16, -1);
+    QCOMPARE(receiverPort.readBufferHighWatermark(), qint64(16));
+    QCOMPARE(receiverPort.readBufferLowWatermark(), qint64(8));
+    receiverPort.setReadBufferThrottling(QSerialPort::HardwareControl);
+    QCOMPARE(receiverPort.readBufferThrottling(), QSerialPort::HardwareControl);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy nearlyFullSpy(&receiverPort, &QSerialPort::readBufferNearlyFull);
+    QVERIFY(nearlyFullSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+
+    QTRY_VERIFY_WITH_TIMEOUT(receiverPort.bytesAvailable() >= 16, 500);
+    QCOMPARE(nearlyFullSpy.size(), 1);
+    QVERIFY(!receiverPort.isRequestToSend());
+    // The null modem cable connects RTS of the receiver to CTS of the sender
+    QTRY_VERIFY(!(senderPort.pinoutSignals() & QSerialPort::ClearToSendSignal));
+
+    // A read served from the read buffer alone does not reach readData(),
+    // readAll() does once the buffer is empty
+    receiverPort.readAll();
+    QVERIFY(receiverPort.isRequestToSend());
+    QTRY_VERIFY(senderPort.pinoutSignals() & QSerialPort::ClearToSendSignal);
+    QCOMPARE(receiverPort.error(), QSerialPort::NoError);
+}
+
+void tst_QSerialPort::readChunk()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+    QVERIFY(receiverPort.readChunk().isEmpty());
+
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+        QVERIFY(senderPort.waitForBytesWritten(500));
+
+        QByteArray received;
+        while (received.size() < alphabetArray.size()) {
+            if (!receiverPort.bytesAvailable())
+                QVERIFY(receiverPort.waitForReadyRead(500));
+            received += receiverPort.readChunk();
+        }
+        QCOMPARE(received, alphabetArray);
+        QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+    }
+}
+
+void tst_QSerialPort::brokerFanOut()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("QSerialPortBroker is only available on Unix platforms");
+#else
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::ReadWrite));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadWrite));
+
+    const QString name = QStringLiteral("tst_qserialport_broker_%1")
+            .arg(QCoreApplication::applicationPid());
+    QSerialPortBroker broker;
+    QVERIFY2(broker.listen(&receiverPort, name), qPrintable(broker.errorString()));
+    QVERIFY(broker.isListening());
+    const QFileDevice::Permissions others = QFileDevice::ReadGroup | QFileDevice::WriteGroup
+            | QFileDevice::ReadOther | QFileDevice::WriteOther;
+    QCOMPARE(QFileInfo(broker.fullServerName()).permissions() & others,
+             QFileDevice::Permissions());
+
+    QSerialPortBrokerClient readWriteClient(name);
+    QVERIFY2(readWriteClient.open(QIODevice::ReadWrite), qPrintable(readWriteClient.errorString()));
+    QSerialPortBrokerClient readOnlyClient(name);
+    QVERIFY2(readOnlyClient.open(QIODevice::ReadOnly), qPrintable(readOnlyClient.errorString()));
+    QTRY_COMPARE(broker.clientCount(), 2);
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(readWriteClient.bytesAvailable(), qint64(alphabetArray.size()));
+    QTRY_COMPARE(readOnlyClient.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(readWriteClient.readAll(), alphabetArray);
+    QCOMPARE(readOnlyClient.readAll(), alphabetArray);
+
+    QCOMPARE(readWriteClient.write(newlineArray), qint64(newlineArray.size()));
+    QTRY_COMPARE(senderPort.bytesAvailable(), qint64(newlineArray.size()));
+    QCOMPARE(senderPort.readAll(), newlineArray);
+    QCOMPARE(readWriteClient.bytesToWrite(), qint64(0));
+
+    // A request is forwarded as a whole, so it cannot exceed the limit
+    QCOMPARE(readWriteClient.write(QByteArray(1024 * 1024 + 1, 'x')), qint64(-1));
+    QCOMPARE(readWriteClient.bytesToWrite(), qint64(0));
+
+    QSignalSpy disconnectedSpy(&readOnlyClient, &QSerialPortBrokerClient::disconnected);
+    broker.close();
+    QVERIFY(!broker.isListening());
+    QTRY_COMPARE(disconnectedSpy.size(), 1);
+    QVERIFY(!readOnlyClient.isConnected());
+#endif
+}
+
+void tst_QSerialPort::captureAndReplay()
+{
+    QTemporaryFile captureFile;
+    QVERIFY(captureFile.open());
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.setBaudRate(QSerialPort::Baud19200));
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.setBaudRate(QSerialPort::Baud19200));
+    receiverPort.setCaptureDevice(&captureFile);
+    QCOMPARE(receiverPort.captureDevice(), &captureFile);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QByteArray received;
+    while (received.size() < alphabetArray.size() && receiverPort.waitForReadyRead(500))
+        received += receiverPort.readAll();
+    QCOMPARE(received, alphabetArray);
+
+    receiverPort.setCaptureDevice(nullptr);
+    QVERIFY(captureFile.flush());
+
+    QSerialPortReplay replay(captureFile.fileName());
+    replay.setReplayMode(QSerialPortReplay::AsFastAsPossible);
+    QVERIFY2(replay.open(QIODevice::ReadOnly), qPrintable(replay.errorString()));
+    QVERIFY(replay.waitForReadyRead(500));
+    QCOMPARE(replay.readAll(), alphabetArray);
+    QVERIFY(replay.atEnd());
+    QCOMPARE(replay.baudRate(), qint32(QSerialPort::Baud19200));
+}
+
+void tst_QSerialPort::loopbackBackend()
+{
+    QSerialPort serialPort(QStringLiteral("loopback://test"));
+    QCOMPARE(serialPort.portName(), QStringLiteral("loopback://test"));
+    QVERIFY(serialPort.open(QIODevice::ReadWrite));
+
+    QSignalSpy bytesWrittenSpy(&serialPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+
+    QCOMPARE(serialPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY(serialPort.waitForReadyRead(500));
+    QCOMPARE(serialPort.readAll(), alphabetArray);
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+
+    QVERIFY(serialPort.setDataTerminalReady(true));
+    QVERIFY(serialPort.pinoutSignals() & QSerialPort::DataSetReadySignal);
+    QVERIFY(serialPort.setBaudRate(QSerialPort::Baud115200));
+
+    QCOMPARE(serialPort.write(newlineArray), qint64(newlineArray.size()));
+    QTRY_COMPARE(serialPort.bytesAvailable(), qint64(newlineArray.size()));
+    QCOMPARE(serialPort.readAll(), newlineArray);
+    QCOMPARE(serialPort.error(), QSerialPort::NoError);
+}
+
+void tst_QSerialPort::openAll()
+{
+    QSerialPort senderPort(m_senderPortName);
+    senderPort.setBaudRate(QSerialPort::Baud115200);
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setBaudRate(QSerialPort::Baud115200);
+    QSerialPort missingPort(QStringLiteral("qserialport_no_such_port"));
+
+    QVERIFY(!QSerialPort::openAll({ &senderPort, &receiverPort, &missingPort },
+                                  QIODevice::ReadWrite));
+    QVERIFY(senderPort.isOpen());
+    QVERIFY(receiverPort.isOpen());
+    QVERIFY(!missingPort.isOpen());
+    QCOMPARE(missingPort.error(), QSerialPort::DeviceNotFoundError);
+
+    const QByteArray data("openAll");
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(receiverPort.readAll(), data);
+}
+
+void tst_QSerialPort::ioThread()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("The I/O thread is only supported on Unix");
+#else
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setIoThreadEnabled(true);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    const QByteArray data("ioThread");
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QVERIFY(receiverPort.waitForReadyRead(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(receiverPort.readAll(), data);
+
+    const QSerialPortLatencyStatistics statistics = receiverPort.latencyStatistics();
+    QVERIFY(statistics.readCount() > 0);
+    QVERIFY(statistics.deliveryCount() > 0);
+    QVERIFY(statistics.minimumWakeupToRead() <= statistics.maximumWakeupToRead());
+    receiverPort.resetLatencyStatistics();
+    QCOMPARE(receiverPort.latencyStatistics().readCount(), qint64(0));
+    receiverPort.close();
+
+    // Asking for an out of range priority fails the open
+    receiverPort.setIoThreadScheduling(QSerialPort::FifoScheduling, -1);
+    QVERIFY(!receiverPort.open(QIODevice::ReadOnly));
+    QVERIFY(!receiverPort.isOpen());
+#endif
+}
+
+void tst_QSerialPort::dataHandler()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    QByteArray handled;
+    QSignalSpy readyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    receiverPort.setDataHandler([&handled](QByteArrayView data) {
+        handled += data;
+    });
+
+    const QByteArray data("dataHandler");
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(handled, data);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+    QCOMPARE(readyReadSpy.size(), 0);
+
+    // Without a handler the data goes to the read buffer again
+    receiverPort.setDataHandler({});
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(handled, data);
+}
+
+void tst_QSerialPort::framing_data()
+{
+    QTest::addColumn<QSerialPort::Framing>("framing");
+    QTest::addColumn<QByteArray>("encoded");
+
+    const QByteArray frame("a\xc0\xdb\x7e\x7d\x00z", 7);
+    QTest::newRow("slip") << QSerialPort::SlipFraming
+                          << QByteArray("\xc0" "a\xdb\xdc\xdb\xdd\x7e\x7d\x00z\xc0", 11);
+    QTest::newRow("cobs") << QSerialPort::CobsFraming
+                          << QByteArray("\x06" "a\xc0\xdb\x7e\x7d\x02z\x00", 9);
+    QTest::newRow("hdlc") << QSerialPort::HdlcFraming
+                          << QByteArray("\x7e" "a\xc0\xdb\x7d\x5e\x7d\x5d\x00z\x7e", 11);
+}
+
+void tst_QSerialPort::framing()
+{
+    QFETCH(QSerialPort::Framing, framing);
+    QFETCH(QByteArray, encoded);
+    const QByteArray frame("a\xc0\xdb\x7e\x7d\x00z", 7);
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    senderPort.setFraming(framing);
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    // Check the encoding on the wire
+    QCOMPARE(senderPort.writeFrame(frame), qint64(frame.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(encoded.size()));
+    QCOMPARE(receiverPort.readAll(), encoded);
+
+    receiverPort.setFraming(framing);
+    QSignalSpy frameSpy(&receiverPort, &QSerialPort::frameReceived);
+
+    // A frame split over two writes is reassembled
+    QCOMPARE(senderPort.write(encoded.left(3)), qint64(3));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTest::qWait(50);
+    QCOMPARE(frameSpy.size(), 0);
+    QCOMPARE(senderPort.write(encoded.mid(3)), qint64(encoded.size() - 3));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+
+    QTRY_COMPARE(frameSpy.size(), 1);
+    QCOMPARE(frameSpy.at(0).at(0).toByteArray(), frame);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+}
+
+void tst_QSerialPort::frameCheck()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    senderPort.setFraming(QSerialPort::SlipFraming);
+    senderPort.setFrameCheck(QSerialPort::Crc16ModbusCheck);
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+    receiverPort.setFraming(QSerialPort::SlipFraming);
+    receiverPort.setFrameCheck(QSerialPort::Crc16ModbusCheck);
+    QSignalSpy frameSpy(&receiverPort, &QSerialPort::frameReceived);
+
+    // The Modbus request "read holding register 0 of device 1"
+    const QByteArray frame = QByteArray::fromHex("010300000001");
+    QCOMPARE(senderPort.writeFrame(frame), qint64(frame.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(frameSpy.size(), 1);
+    QCOMPARE(frameSpy.at(0).at(0).toByteArray(), frame);
+
+    // The same frame with a corrupted check sequence is dropped
+    const QByteArray corrupted = QByteArray::fromHex("c0010300000001840bc0");
+    QCOMPARE(senderPort.write(corrupted), qint64(corrupted.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.frameCheckErrorCount(), qint64(1));
+    QCOMPARE(frameSpy.size(), 1);
+}
+
+class XorFilter : public QSerialPortFilter
+{
+public:
+    void processInbound(QByteArrayView data, Output &output) override { process(data, output); }
+    void processOutbound(QByteArrayView data, Output &output) override { process(data, output); }
+
+private:
+    void process(QByteArrayView data, Output &output)
+    {
+        scratch.resize(data.size());
+        for (qsizetype i = 0; i < data.size(); ++i)
+            scratch[i] = data[i] ^ 0x5a;
+        output.write(scratch);
+    }
+
+    QByteArray scratch;
+};
+
+void tst_QSerialPort::filters()
+{
+    XorFilter senderFilter;
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    senderPort.addFilter(&senderFilter);
+
+    XorFilter receiverFilter;
+    QSerialPortFilter passThrough;
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+    receiverPort.addFilter(&passThrough);
+    receiverPort.addFilter(&receiverFilter);
+    QCOMPARE(receiverPort.filters().size(), 2);
+
+    const QByteArray data("filters");
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(receiverPort.readAll(), data);
+
+    // Without the filter, the scrambled bytes come through
+    receiverPort.removeFilter(&receiverFilter);
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QVERIFY(receiverPort.readAll() != data);
+
+    // With a bounded write buffer, a filtered write is taken whole or not at all
+    senderPort.setWriteBufferMaxSize(4);
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QCOMPARE(senderPort.write(data), qint64(0));
+    QCOMPARE(senderPort.bytesToWrite(), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+}
+
+void tst_QSerialPort::compression()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    senderPort.setCompression(QSerialPort::Lz4Compression);
+    QCOMPARE(senderPort.compression(), QSerialPort::Lz4Compression);
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+    receiverPort.setCompression(QSerialPort::Lz4Compression);
+
+    // More than a block, and a short block left for the flush timeout
+    const QByteArray data = alphabetArray.repeated(200);
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.bytesToWrite() > 0);
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(receiverPort.readAll(), data);
+
+    const QSerialPortCompressionStatistics sent = senderPort.compressionStatistics();
+    QCOMPARE(sent.uncompressedBytesWritten(), qint64(data.size()));
+    QVERIFY(sent.writeRatio() > 2);
+    const QSerialPortCompressionStatistics received = receiverPort.compressionStatistics();
+    QCOMPARE(received.uncompressedBytesRead(), qint64(data.size()));
+    QCOMPARE(received.compressedBytesRead(), sent.compressedBytesWritten());
+
+    // Incompressible data is stored as it is
+    senderPort.resetCompressionStatistics();
+    const QByteArray noise = QByteArray::fromHex("9c3b7f02e1d4a85566c30f1e27b9d840");
+    senderPort.setCompressionFlushTimeout(0);
+    QCOMPARE(senderPort.write(noise), qint64(noise.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(noise.size()));
+    QCOMPARE(receiverPort.readAll(), noise);
+    QCOMPARE(senderPort.compressionStatistics().compressedBytesWritten(), qint64(noise.size() + 4));
+
+    // After an invalid block header, the received data is dropped until the
+    // input is cleared
+    senderPort.setCompression(QSerialPort::NoCompression);
+    QCOMPARE(senderPort.write(QByteArray(4, '\0')), qint64(4));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.error(), QSerialPort::ReadError);
+    receiverPort.clearError();
+    senderPort.setCompression(QSerialPort::Lz4Compression);
+    QCOMPARE(senderPort.write(noise), qint64(noise.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTest::qWait(100);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+    QCOMPARE(receiverPort.error(), QSerialPort::NoError);
+
+    QVERIFY(receiverPort.clear(QSerialPort::Input));
+    QCOMPARE(senderPort.write(noise), qint64(noise.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(noise.size()));
+    QCOMPARE(receiverPort.readAll(), noise);
+}
+
+void tst_QSerialPort::compressionWithLimitedWriteBuffer_data()
+{
+    QTest::addColumn<QSerialPort::WriteBufferPolicy>("policy");
+
+    QTest::newRow("RejectWhenFull") << QSerialPort::RejectWhenFull;
+    QTest::newRow("BlockWhenFull") << QSerialPort::BlockWhenFull;
+    QTest::newRow("DropOldestWhenFull") << QSerialPort::DropOldestWhenFull;
+}
+
+void tst_QSerialPort::compressionWithLimitedWriteBuffer()
+{
+    QFETCH(QSerialPort::WriteBufferPolicy, policy);
+
+    QSerialPort senderPort(m_senderPortName);
+    senderPort.setWriteBufferMaxSize(64);
+    senderPort.setWriteBufferPolicy(policy);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    senderPort.setCompression(QSerialPort::Lz4Compression);
+    senderPort.setCompressionFlushTimeout(0);
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+    receiverPort.setCompression(QSerialPort::Lz4Compression);
+
+    // Incompressible blocks larger than the write buffer: whatever a write
+    // takes has to arrive in one piece, with the block headers in step
+    QRandomGenerator generator(42);
+    QByteArray expected;
+    for (int i = 0; i < 4; ++i) {
+        QByteArray chunk(3000, Qt::Uninitialized);
+        for (char &c : chunk)
+            c = char(generator.bounded(256));
+        const qint64 written = senderPort.write(chunk);
+        QVERIFY(written >= 0);
+        expected.append(chunk.left(written));
+    }
+    QVERIFY(expected.size() > 3000);
+
+    QTRY_COMPARE_WITH_TIMEOUT(receiverPort.bytesAvailable(), qint64(expected.size()), 5000);
+    QCOMPARE(receiverPort.readAll(), expected);
+    QCOMPARE(receiverPort.error(), QSerialPort::NoError);
+}
+
+void tst_QSerialPort::blockingMode()
+{
+    QSerialPort senderPort(m_senderPortName);
+    senderPort.setBlockingModeEnabled(true);
+    QVERIFY(senderPort.isBlockingModeEnabled());
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setBlockingModeEnabled(true);
+    receiverPort.setInterByteTimeout(100);
+    QCOMPARE(receiverPort.interByteTimeout(), 100);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+
+    QByteArray data(alphabetArray.size(), Qt::Uninitialized);
+    qint64 received = 0;
+    while (received < data.size()) {
+        const qint64 bytes = receiverPort.read(data.data() + received, data.size() - received);
+        QVERIFY(bytes > 0);
+        received += bytes;
+    }
+    QCOMPARE(data, alphabetArray);
+
+    // readAll() returns once the data pending in the driver has been read
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(newlineArray.size()));
+    QCOMPARE(receiverPort.readAll(), newlineArray);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+}
+
+void tst_QSerialPort::transmitComplete()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    QSignalSpy transmitCompleteSpy(&senderPort, &QSerialPort::transmitComplete);
+    QVERIFY(transmitCompleteSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY(senderPort.waitForTransmitComplete(QDeadlineTimer(1000)));
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+    QCOMPARE(transmitCompleteSpy.size(), 1);
+
+    // Without waiting, the signal follows bytesWritten()
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QTRY_COMPARE(transmitCompleteSpy.size(), 2);
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(2 * alphabetArray.size()));
+}
+
+void tst_QSerialPort::driverQueueSizes()
+{
+    QSerialPort serialPort(m_senderPortName);
+    QSerialPort::DriverQueueSizes sizes = serialPort.driverQueueSizes();
+    QCOMPARE(sizes.input, qint64(-1));
+    QCOMPARE(sizes.output, qint64(-1));
+    QCOMPARE(serialPort.error(), QSerialPort::NotOpenError);
+
+    QVERIFY(serialPort.open(QIODevice::ReadWrite));
+    sizes = serialPort.driverQueueSizes();
+    QVERIFY(sizes.input >= 0);
+    QVERIFY(sizes.output >= 0);
+}
+
+void tst_QSerialPort::lineErrorReporting()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.setLineErrorReportingEnabled(true));
+    QVERIFY(receiverPort.isLineErrorReportingEnabled());
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    // The driver escapes 0xFF data bytes, which must come through unchanged
+    const QByteArray data = QByteArray::fromHex("41ff00ffff0042");
+    QCOMPARE(senderPort.write(data), qint64(data.size()));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(data.size()));
+    QCOMPARE(receiverPort.readAll(), data);
+    QVERIFY(receiverPort.takeLineErrors().isEmpty());
+
+    // A break between two writes is reported at the position of the byte
+    // after it, counting all the bytes received since the port was opened
+    QSignalSpy lineErrorsSpy(&receiverPort, &QSerialPort::lineErrorsReceived);
+    QVERIFY(lineErrorsSpy.isValid());
+    QCOMPARE(senderPort.write("AB"), qint64(2));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(2));
+
+    QVERIFY(senderPort.setBreakEnabled(true));
+    QTest::qWait(50);
+    QVERIFY(senderPort.setBreakEnabled(false));
+    QCOMPARE(senderPort.write("CD"), qint64(2));
+    QVERIFY(senderPort.waitForBytesWritten(500));
+
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(4));
+    QCOMPARE(receiverPort.readAll(), QByteArray("ABCD"));
+    QVERIFY(lineErrorsSpy.size() > 0);
+    const QList<QSerialPort::LineError> errors = receiverPort.takeLineErrors();
+    QVERIFY(!errors.isEmpty());
+    QCOMPARE(errors.first().type, QSerialPort::BreakCondition);
+    QCOMPARE(errors.first().position, qint64(data.size() + 2));
+    QVERIFY(receiverPort.takeLineErrors().isEmpty());
+}
+
+void tst_QSerialPort::nineBitMode()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("The 9-bit mode is only supported on Linux");
+#endif
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.setNineBitModeEnabled(true));
+    QVERIFY(senderPort.open(QIODevice::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.setNineBitModeEnabled(true));
+    QVERIFY(receiverPort.isNineBitModeEnabled());
+    QVERIFY(receiverPort.open(QIODevice::ReadOnly));
+
+    const QList<quint16> words = { 0x101, 0x0ff, 0x042, 0x1ff, 0x100 };
+    QCOMPARE(senderPort.writeNineBit(words), qint64(words.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(words.size()));
+    QCOMPARE(receiverPort.readNineBit(words.size()), words);
+    QVERIFY(receiverPort.takeLineErrors().isEmpty());
+
+    // Compression changes the data that the 9th bits refer to
+    receiverPort.setCompression(QSerialPort::Lz4Compression);
+    QVERIFY(receiverPort.readNineBit(words.size()).isEmpty());
+    QCOMPARE(receiverPort.error(), QSerialPort::UnsupportedOperationError);
+    receiverPort.clearError();
+    QVERIFY(receiverPort.setNineBitModeEnabled(false));
+    QVERIFY(!receiverPort.setNineBitModeEnabled(true));
+    QCOMPARE(receiverPort.error(), QSerialPort::UnsupportedOperationError);
+}
+
 void tst_QSerialPort::waitForReadyReadWithTimeout()
 {
     // the dummy device on other side also has to be open
@@ -1306,6 +2027,21 @@ void tst_QSerialPort::bindingsAndProperties()
         return;
     }
 
+    // -- RS-485 configuration
+
+    QSerialPortRs485Configuration rs485;
+    rs485.setEnabled(true);
+    rs485.setDelayBeforeSend(std::chrono::milliseconds(1));
+    QSerialPortRs485Configuration rs485Echo = rs485;
+    rs485Echo.setReceiveDuringTransmitEnabled(true);
+
+    QTestPrivate::testReadWritePropertyBasics(sp, rs485, rs485Echo, "rs485Configuration");
+    if (QTest::currentTestFailed()) {
+        qDebug("Failed property test for QSetialPort::rs485Configuration");
+        return;
+    }
+    sp.setRs485Configuration(QSerialPortRs485Configuration());
+
     // -- error
 
     QTestPrivate::testReadOnlyPropertyBasics(
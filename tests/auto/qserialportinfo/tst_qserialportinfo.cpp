@@ -16,6 +16,9 @@ private slots:
 
     void constructors();
     void assignment();
+    void capabilities();
+    void enumerationCache();
+    void availablePortsAsync();
 
 private:
     QString m_senderPortName;
@@ -81,5 +84,66 @@ void tst_QSerialPortInfo::assignment()
     QVERIFY(!exist2.isNull());
 }
 
+void tst_QSerialPortInfo::capabilities()
+{
+    const QSerialPortCapabilities empty = QSerialPortInfo().capabilities();
+    QCOMPARE(empty.maximumBaudRate(), 0);
+    QCOMPARE(empty.fifoSize(), 0);
+    QVERIFY(!empty.hasCustomBaudRateDivisor());
+    QCOMPARE(empty.usbSpeed(), 0);
+    QVERIFY(empty.driver().isEmpty());
+
+    const QSerialPortInfo exist(m_senderPortName);
+    const QSerialPortCapabilities capabilities = exist.capabilities();
+    QVERIFY(capabilities.maximumBaudRate() >= 0);
+    QVERIFY(capabilities.fifoSize() >= 0);
+    QVERIFY(capabilities.usbSpeed() >= 0);
+
+    QSerialPortCapabilities copy;
+    copy = capabilities;
+    QCOMPARE(copy.maximumBaudRate(), capabilities.maximumBaudRate());
+    QCOMPARE(copy.driver(), capabilities.driver());
+}
+
+void tst_QSerialPortInfo::enumerationCache()
+{
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && !defined(Q_OS_FREEBSD)
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("ports.cache"));
+
+    QSerialPortInfo::setEnumerationCacheFileName(fileName);
+    QCOMPARE(QSerialPortInfo::enumerationCacheFileName(), fileName);
+
+    QStringList scanned;
+    for (const QSerialPortInfo &info : QSerialPortInfo::availablePorts())
+        scanned << info.portName();
+    QVERIFY(QFile::exists(fileName));
+
+    QStringList cached;
+    for (const QSerialPortInfo &info : QSerialPortInfo::availablePorts())
+        cached << info.portName();
+    QSerialPortInfo::setEnumerationCacheFileName(QString());
+
+    QCOMPARE(cached, scanned);
+    QVERIFY(cached.contains(m_senderPortName));
+#else
+    QSKIP("The enumeration cache is not used on this platform");
+#endif
+}
+
+void tst_QSerialPortInfo::availablePortsAsync()
+{
+    QFuture<QList<QSerialPortInfo>> future = QSerialPortInfo::availablePortsAsync();
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), 1);
+
+    QStringList names;
+    for (const QSerialPortInfo &info : future.result())
+        names << info.portName();
+    QVERIFY(names.contains(m_senderPortName));
+    QVERIFY(names.contains(m_receiverPortName));
+}
+
 QTEST_MAIN(tst_QSerialPortInfo)
 #include "tst_qserialportinfo.moc"
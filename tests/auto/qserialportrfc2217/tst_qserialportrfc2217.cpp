@@ -0,0 +1,130 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtSerialPort/QSerialPort>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+// Talks to a stand-in for a network device server that listens on the
+// loopback interface, so no serial hardware is needed.
+class tst_QSerialPortRfc2217 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void settings();
+    void data();
+    void modemState();
+    void connectionLost();
+
+private:
+    bool openPort(QSerialPort &serialPort);
+
+    QTcpServer m_server;
+    QTcpSocket *m_socket = nullptr;
+    QByteArray m_received;
+};
+
+static bool receiveUntil(QTcpSocket *socket, QByteArray &received, const QByteArray &expected)
+{
+    QDeadlineTimer deadline(5000);
+    while (!received.contains(expected)) {
+        QCoreApplication::processEvents();
+        received += socket->readAll();
+        if (deadline.hasExpired())
+            return false;
+        socket->waitForReadyRead(10);
+        received += socket->readAll();
+    }
+    return true;
+}
+
+void tst_QSerialPortRfc2217::initTestCase()
+{
+    QVERIFY(m_server.listen(QHostAddress::LocalHost));
+}
+
+bool tst_QSerialPortRfc2217::openPort(QSerialPort &serialPort)
+{
+    delete m_socket;
+    m_socket = nullptr;
+    m_received.clear();
+
+    serialPort.setPortName(QStringLiteral("rfc2217://127.0.0.1:%1").arg(m_server.serverPort()));
+    if (!serialPort.open(QIODevice::ReadWrite))
+        return false;
+    if (!m_server.waitForNewConnection(5000))
+        return false;
+    m_socket = m_server.nextPendingConnection();
+    return m_socket != nullptr;
+}
+
+void tst_QSerialPortRfc2217::settings()
+{
+    QSerialPort serialPort;
+    serialPort.setBaudRate(QSerialPort::Baud115200);
+    QVERIFY(openPort(serialPort));
+
+    // IAC WILL COM-PORT-OPTION
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffb2c")));
+    // IAC SB COM-PORT-OPTION SET-BAUDRATE 115200 IAC SE
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffa2c010001c200fff0")));
+
+    // A value byte of 0xff is doubled inside the subnegotiation
+    QVERIFY(serialPort.setBaudRate(0xff00));
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffa2c010000ffff00fff0")));
+
+    QVERIFY(serialPort.setParity(QSerialPort::EvenParity));
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffa2c0303fff0")));
+
+    QVERIFY(serialPort.setFlowControl(QSerialPort::HardwareControl));
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffa2c0503fff0")));
+
+    QVERIFY(serialPort.setBreakEnabled(true));
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray::fromHex("fffa2c0505fff0")));
+}
+
+void tst_QSerialPortRfc2217::data()
+{
+    QSerialPort serialPort;
+    QVERIFY(openPort(serialPort));
+
+    const QByteArray written("x\xffy", 3);
+    QCOMPARE(serialPort.write(written), qint64(written.size()));
+    QVERIFY(receiveUntil(m_socket, m_received, QByteArray("x\xff\xffy", 4)));
+
+    // Echo it back the way the device server would send it
+    m_socket->write(QByteArray("x\xff\xffy", 4));
+    QTRY_COMPARE(serialPort.bytesAvailable(), qint64(written.size()));
+    QCOMPARE(serialPort.readAll(), written);
+}
+
+void tst_QSerialPortRfc2217::modemState()
+{
+    QSerialPort serialPort;
+    QVERIFY(openPort(serialPort));
+
+    // IAC SB COM-PORT-OPTION NOTIFY-MODEMSTATE CTS|DSR IAC SE, then data
+    m_socket->write(QByteArray::fromHex("fffa2c6b30fff0") + "z");
+    QTRY_COMPARE(serialPort.bytesAvailable(), qint64(1));
+
+    const QSerialPort::PinoutSignals pinout = serialPort.pinoutSignals();
+    QVERIFY(pinout & QSerialPort::ClearToSendSignal);
+    QVERIFY(pinout & QSerialPort::DataSetReadySignal);
+    QVERIFY(!(pinout & QSerialPort::DataCarrierDetectSignal));
+}
+
+void tst_QSerialPortRfc2217::connectionLost()
+{
+    QSerialPort serialPort;
+    QVERIFY(openPort(serialPort));
+
+    m_socket->disconnectFromHost();
+    QTRY_COMPARE(serialPort.error(), QSerialPort::ResourceError);
+}
+
+QTEST_MAIN(tst_QSerialPortRfc2217)
+#include "tst_qserialportrfc2217.moc"